@@ -0,0 +1,210 @@
+#ifndef BOARDSTATE_H
+#define BOARDSTATE_H
+
+#include <cstdint>
+
+///
+/// \brief The boardState class
+///
+/// Compact 3 x 3 game state, one 9-bit mask per player. Cells are
+/// numbered row-major (index = row*3 + col) and every win, draw or
+/// legal move query is a mask test against the 8 win lines. The game
+/// status is updated incrementally on each move, checking only the
+/// lines crossing the cell just played.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class boardState
+{
+public:
+    // Cell values, same as the ones the neural network was trained with
+    enum player {O_PLAYER = 0, X_PLAYER = 1};
+    enum status {IN_PROGRESS, O_WON, X_WON, DRAW};
+
+    static const int TOTAL_CELLS      = 9;
+    static const int TOTAL_WIN_LINES  = 8;
+    static const int TOTAL_SYMMETRIES = 8;
+    static const int EMPTY_CELL       = -1;
+    static constexpr uint16_t FULL_BOARD = 0x1FF;
+
+    // 3 rows, 3 cols, main diagonal and anti diagonal
+    static constexpr uint16_t WIN_LINES[TOTAL_WIN_LINES] = { 0x007, 0x038, 0x1C0,
+                                                             0x049, 0x092, 0x124,
+                                                             0x111, 0x054 };
+
+    // Where every cell goes under the 8 symmetries of the square: identity,
+    // rotations by 90, 180 and 270 degrees, horizontal and vertical flips,
+    // and reflections over both diagonals.
+    static constexpr uint8_t SYMMETRIES[TOTAL_SYMMETRIES][TOTAL_CELLS] = { {0, 1, 2, 3, 4, 5, 6, 7, 8},
+                                                                          {2, 5, 8, 1, 4, 7, 0, 3, 6},
+                                                                          {8, 7, 6, 5, 4, 3, 2, 1, 0},
+                                                                          {6, 3, 0, 7, 4, 1, 8, 5, 2},
+                                                                          {2, 1, 0, 5, 4, 3, 8, 7, 6},
+                                                                          {6, 7, 8, 3, 4, 5, 0, 1, 2},
+                                                                          {0, 3, 6, 1, 4, 7, 2, 5, 8},
+                                                                          {8, 5, 2, 7, 4, 1, 6, 3, 0} };
+    static constexpr int INVERSE_SYMMETRY[TOTAL_SYMMETRIES] = {0, 3, 2, 1, 4, 5, 6, 7};
+
+    constexpr boardState() : mMasks{0, 0}, mStatus(IN_PROGRESS), mWinLine(-1) {};
+    constexpr boardState(const uint16_t oMask, const uint16_t xMask) :
+        mMasks{oMask, xMask}, mStatus(IN_PROGRESS), mWinLine(-1) { refreshStatus(); };
+
+    constexpr uint16_t mask(const player p) const { return mMasks[p]; };
+    constexpr uint16_t occupied() const { return mMasks[O_PLAYER] | mMasks[X_PLAYER]; };
+    constexpr uint16_t emptyCells() const { return FULL_BOARD & ~occupied(); };
+    constexpr int moveCount() const { return popCount(occupied()); };
+    constexpr bool isLegal(const int index) const {
+        return mStatus==IN_PROGRESS && index>=0 && index<TOTAL_CELLS && (emptyCells() & (1u << index));
+    };
+    constexpr int cell(const int index) const {
+        return (mMasks[O_PLAYER] & (1u << index)) ? O_PLAYER :
+               (mMasks[X_PLAYER] & (1u << index)) ? X_PLAYER : EMPTY_CELL;
+    };
+
+    constexpr status gameStatus() const { return mStatus; };
+    constexpr bool isOver() const { return mStatus!=IN_PROGRESS; };
+    constexpr int winningLine() const { return mWinLine; };
+
+    // Sets a mark and updates the status, the move must be legal
+    constexpr void play(const int index, const player p) {
+        mMasks[p] |= static_cast<uint16_t>(1u << index);
+
+        for(int i=0; i<TOTAL_WIN_LINES; i++){
+            if((WIN_LINES[i] & (1u << index)) && (mMasks[p] & WIN_LINES[i])==WIN_LINES[i]){
+                mStatus = (p==X_PLAYER) ? X_WON : O_WON;
+                mWinLine = i;
+                return;
+            }
+        }
+
+        if(occupied()==FULL_BOARD){
+            mStatus = DRAW;
+        }
+    };
+
+    // Takes back the last move played in index
+    constexpr void undo(const int index) {
+        mMasks[O_PLAYER] &= static_cast<uint16_t>(~(1u << index));
+        mMasks[X_PLAYER] &= static_cast<uint16_t>(~(1u << index));
+        mStatus = IN_PROGRESS;
+        mWinLine = -1;
+    };
+
+    constexpr void clear() { *this = boardState(); };
+
+    // Neural network input, TOTAL_CELLS cell values
+    constexpr void toCells(int *cells) const {
+        for(int i=0; i<TOTAL_CELLS; i++){
+            cells[i] = cell(i);
+        }
+    };
+
+    constexpr bool operator==(const boardState &other) const {
+        return mMasks[O_PLAYER]==other.mMasks[O_PLAYER] && mMasks[X_PLAYER]==other.mMasks[X_PLAYER];
+    };
+
+    // 18-bit key, O marks in the low bits
+    constexpr uint32_t key() const { return mMasks[O_PLAYER] | (static_cast<uint32_t>(mMasks[X_PLAYER]) << TOTAL_CELLS); };
+
+    constexpr boardState transformed(const int symmetry) const;
+
+    // Smallest key among the 8 symmetric boards, and the symmetry giving it
+    constexpr uint32_t canonicalKey(int *symmetry = nullptr) const;
+
+    static constexpr uint16_t transformMask(const uint16_t mask, const int symmetry) {
+        uint16_t retVal = 0;
+        for(int i=0; i<TOTAL_CELLS; i++){
+            if(mask & (1u << i)){
+                retVal |= static_cast<uint16_t>(1u << SYMMETRIES[symmetry][i]);
+            }
+        }
+        return retVal;
+    };
+
+    static constexpr bool hasWinLine(const uint16_t mask) {
+        for(int i=0; i<TOTAL_WIN_LINES; i++){
+            if((mask & WIN_LINES[i])==WIN_LINES[i]){
+                return true;
+            }
+        }
+        return false;
+    };
+
+    static constexpr int popCount(uint16_t mask) {
+        int count = 0;
+        for(; mask!=0; mask &= static_cast<uint16_t>(mask - 1)){
+            count++;
+        }
+        return count;
+    };
+
+protected:
+    uint16_t mMasks[2];
+    status mStatus;
+    int mWinLine;
+
+    // Full status check, only needed for boards built from raw masks
+    constexpr void refreshStatus() {
+        for(int i=0; i<TOTAL_WIN_LINES; i++){
+            if((mMasks[X_PLAYER] & WIN_LINES[i])==WIN_LINES[i]){
+                mStatus = X_WON;
+                mWinLine = i;
+                return;
+            }
+            if((mMasks[O_PLAYER] & WIN_LINES[i])==WIN_LINES[i]){
+                mStatus = O_WON;
+                mWinLine = i;
+                return;
+            }
+        }
+        mStatus = (occupied()==FULL_BOARD) ? DRAW : IN_PROGRESS;
+        mWinLine = -1;
+    };
+};
+
+///
+/// \brief The symmetryMasks struct Every 9-bit mask under every symmetry, so
+/// transforming or canonicalizing a board costs table loads only.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+struct symmetryMasks {
+    uint16_t masks[boardState::TOTAL_SYMMETRIES][boardState::FULL_BOARD + 1];
+
+    constexpr symmetryMasks() : masks() {
+        for(int s=0; s<boardState::TOTAL_SYMMETRIES; s++){
+            for(int mask=0; mask<=boardState::FULL_BOARD; mask++){
+                masks[s][mask] = boardState::transformMask(static_cast<uint16_t>(mask), s);
+            }
+        }
+    };
+};
+
+inline constexpr symmetryMasks SYMMETRY_MASKS;
+
+constexpr boardState boardState::transformed(const int symmetry) const
+{
+    return boardState(SYMMETRY_MASKS.masks[symmetry][mMasks[O_PLAYER]], SYMMETRY_MASKS.masks[symmetry][mMasks[X_PLAYER]]);
+}
+
+constexpr uint32_t boardState::canonicalKey(int *symmetry) const
+{
+    uint32_t retVal = key();
+    int best = 0;
+    for(int s=1; s<TOTAL_SYMMETRIES; s++){
+        const uint32_t k = SYMMETRY_MASKS.masks[s][mMasks[O_PLAYER]] |
+                           (static_cast<uint32_t>(SYMMETRY_MASKS.masks[s][mMasks[X_PLAYER]]) << TOTAL_CELLS);
+        if(k<retVal){
+            retVal = k;
+            best = s;
+        }
+    }
+    if(symmetry!=nullptr){
+        *symmetry = best;
+    }
+    return retVal;
+}
+
+#endif // BOARDSTATE_H
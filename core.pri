@@ -0,0 +1,44 @@
+# Headless game core, shared by the game and the tools.
+# Needs Qt core and concurrent only, no display.
+
+QT += concurrent
+
+INCLUDEPATH += $$PWD
+
+# The batched inference kernels use SSE2 by default on x86-64.
+# Uncomment the following line to build them for AVX2/FMA capable hosts.
+#QMAKE_CXXFLAGS += -mavx2 -mfma
+
+SOURCES += \
+        $$PWD/endgamedatabase.cpp \
+        $$PWD/gamerecord.cpp \
+        $$PWD/gamesession.cpp \
+        $$PWD/inferencecache.cpp \
+        $$PWD/layermatrix.cpp \
+        $$PWD/mctsengine.cpp \
+        $$PWD/mnkboard.cpp \
+        $$PWD/movebatcher.cpp \
+        $$PWD/negamaxsolver.cpp \
+        $$PWD/networkmodel.cpp \
+        $$PWD/perfectplay.cpp \
+        $$PWD/quantizednetwork.cpp \
+        $$PWD/virtualplayer.cpp \
+        $$PWD/workstealingpool.cpp
+
+HEADERS += \
+    $$PWD/boardstate.h \
+    $$PWD/endgamedatabase.h \
+    $$PWD/gamerecord.h \
+    $$PWD/gamesession.h \
+    $$PWD/inferencecache.h \
+    $$PWD/layermatrix.h \
+    $$PWD/mctsengine.h \
+    $$PWD/mnkboard.h \
+    $$PWD/movebatcher.h \
+    $$PWD/negamaxsolver.h \
+    $$PWD/networkmodel.h \
+    $$PWD/perfectplay.h \
+    $$PWD/quantizednetwork.h \
+    $$PWD/staticnetwork.h \
+    $$PWD/virtualplayer.h \
+    $$PWD/workstealingpool.h
@@ -0,0 +1,358 @@
+#include "endgamedatabase.h"
+#include "mnkboard.h"
+
+#include <QtAlgorithms>
+
+#include <cstring>
+
+const char endgameDatabase::FILE_MAGIC[4] = {'T', 'T', 'T', 'E'};
+
+///
+/// \brief endgameDatabase::positionIndex::positionIndex Main constructor, sizes the layers
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param cells Board cells, up to MAX_CELLS
+///
+endgameDatabase::positionIndex::positionIndex(const int cells) :
+    mCells(qBound(0, cells, MAX_CELLS))
+{
+    for(int n=0; n<=MAX_CELLS; n++){
+        for(int k=0; k<=MAX_CELLS; k++){
+            mBinomial[n][k] = (k==0) ? 1 : (k>n) ? 0 : mBinomial[n - 1][k - 1] + mBinomial[n - 1][k];
+        }
+    }
+
+    // Layer of every mark count: occupied cells times the ways to split them
+    mOffsets[0] = 0;
+    for(int marks=0; marks<=mCells; marks++){
+        mOffsets[marks + 1] = mOffsets[marks] + binomial(mCells, marks)*binomial(marks, moverMarks(marks));
+    }
+}
+
+///
+/// \brief endgameDatabase::positionIndex::rank Index of a position
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param mover Cells of the side to move, moverMarks() of the marks on the board
+/// \param opponent Cells of the other side
+///
+/// \return Index, below size()
+///
+quint64 endgameDatabase::positionIndex::rank(const quint64 mover, const quint64 opponent) const
+{
+    const quint64 occupied = mover | opponent;
+    const int marks = qPopulationCount(occupied);
+
+    // The mover cells, numbered among the occupied ones
+    quint64 relative = 0;
+    int j = 0;
+    for(quint64 rest=occupied; rest!=0; rest &= rest - 1, j++){
+        if(mover & rest & (~rest + 1)){
+            relative |= quint64(1) << j;
+        }
+    }
+
+    return mOffsets[marks] + subsetRank(occupied)*binomial(marks, moverMarks(marks)) + subsetRank(relative);
+}
+
+///
+/// \brief endgameDatabase::positionIndex::unrank Position of an index
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param index Index, below size()
+/// \param mover Returns the cells of the side to move
+/// \param opponent Returns the cells of the other side
+///
+void endgameDatabase::positionIndex::unrank(const quint64 index, quint64 &mover, quint64 &opponent) const
+{
+    int marks = 0;
+    while(marks<mCells && index>=mOffsets[marks + 1]){
+        marks++;
+    }
+
+    const quint64 splits = binomial(marks, moverMarks(marks));
+    const quint64 local = index - mOffsets[marks];
+    const quint64 occupied = subsetUnrank(local/splits, marks, mCells);
+    const quint64 relative = subsetUnrank(local%splits, moverMarks(marks), marks);
+
+    mover = 0;
+    int j = 0;
+    for(quint64 rest=occupied; rest!=0; rest &= rest - 1, j++){
+        if(relative & (quint64(1) << j)){
+            mover |= rest & (~rest + 1);
+        }
+    }
+    opponent = occupied & ~mover;
+}
+
+///
+/// \brief endgameDatabase::positionIndex::subsetRank Rank of a set among the sets of its
+/// size, in the combinatorial number system (the sets in increasing bit pattern order).
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param subset Set, as bits
+///
+/// \return Rank
+///
+quint64 endgameDatabase::positionIndex::subsetRank(quint64 subset) const
+{
+    quint64 retVal = 0;
+    for(int i=1; subset!=0; subset &= subset - 1, i++){
+        retVal += binomial(qCountTrailingZeroBits(subset), i);
+    }
+    return retVal;
+}
+
+///
+/// \brief endgameDatabase::positionIndex::subsetUnrank Set of a rank
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param rank Rank, below binomial(universe, size)
+/// \param size Set size
+/// \param universe Bits the set is taken from
+///
+/// \return Set, as bits
+///
+quint64 endgameDatabase::positionIndex::subsetUnrank(quint64 rank, const int size, const int universe) const
+{
+    quint64 retVal = 0;
+    int c = universe;
+    for(int i=size; i>0; i--){
+        do{
+            c--;
+        } while(binomial(c, i)>rank);
+        retVal |= quint64(1) << c;
+        rank -= binomial(c, i);
+    }
+    return retVal;
+}
+
+///
+/// \brief endgameDatabase::endgameDatabase Main constructor, nothing is open
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+endgameDatabase::endgameDatabase() :
+    mRows(0), mCols(0), mWinLength(0), mValues(nullptr), mDistances(nullptr)
+{
+}
+
+///
+/// \brief endgameDatabase::open Maps a database file
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param fileName Database, see tools/retrograde
+///
+/// \return false on error, see errorString()
+///
+bool endgameDatabase::open(const QString &fileName)
+{
+    close();
+    mFile.setFileName(fileName);
+
+    if(!mFile.open(QIODevice::ReadOnly)){
+        mError = mFile.errorString();
+        return false;
+    }
+
+    const qint64 fileSize = mFile.size();
+    const uchar *data = (fileSize>=HEADER_SIZE) ? mFile.map(0, fileSize) : nullptr;
+    if(data==nullptr || memcmp(data, FILE_MAGIC, 4)!=0 || data[4]!=FILE_VERSION ||
+       data[5]*data[6]>MAX_CELLS){
+        mError = fileName + QStringLiteral(" is not an endgame database");
+        if(data!=nullptr){
+            mFile.unmap(const_cast<uchar*>(data));
+        }
+        mFile.close();
+        return false;
+    }
+
+    quint64 positions = 0;
+    for(int i=0; i<8; i++){
+        positions |= static_cast<quint64>(data[12 + i]) << (8*i);
+    }
+    mIndex.reset(new positionIndex(data[5]*data[6]));
+
+    const bool distances = (data[8] & HAS_DISTANCES);
+    const quint64 needed = HEADER_SIZE + (positions + 3)/4 + (distances ? positions : 0);
+    if(positions!=mIndex->size() || static_cast<quint64>(fileSize)<needed){
+        mError = fileName + QStringLiteral(" is truncated or damaged");
+        mFile.unmap(const_cast<uchar*>(data));
+        mFile.close();
+        mIndex.reset();
+        return false;
+    }
+
+    mRows = data[5];
+    mCols = data[6];
+    mWinLength = data[7];
+    mValues = data + HEADER_SIZE;
+    mDistances = distances ? mValues + (positions + 3)/4 : nullptr;
+    return true;
+}
+
+///
+/// \brief endgameDatabase::close Unmaps the database
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void endgameDatabase::close()
+{
+    if(mValues!=nullptr){
+        mFile.unmap(const_cast<uchar*>(mValues - HEADER_SIZE));
+    }
+    mFile.close();
+    mValues = nullptr;
+    mDistances = nullptr;
+    mIndex.reset();
+    mRows = mCols = mWinLength = 0;
+}
+
+///
+/// \brief endgameDatabase::covers Checks the database was solved for a board geometry
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Board
+///
+/// \return true if its positions can be looked up
+///
+bool endgameDatabase::covers(const mnkBoard &board) const
+{
+    return isOpen() && board.rows()==mRows && board.cols()==mCols && board.winLength()==mWinLength;
+}
+
+///
+/// \brief endgameDatabase::value Game-theoretic value of a position
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param mover Cells of the side to move
+/// \param opponent Cells of the other side
+///
+/// \return Value for the side to move
+///
+endgameDatabase::gameValue endgameDatabase::value(const quint64 mover, const quint64 opponent) const
+{
+    const quint64 index = mIndex->rank(mover, opponent);
+    return static_cast<gameValue>((mValues[index >> 2] >> ((index & 3)*2)) & 3);
+}
+
+///
+/// \brief endgameDatabase::distance Plies to the result of a position under best play
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param mover Cells of the side to move
+/// \param opponent Cells of the other side
+///
+/// \return Plies, 0 if the database has no distances
+///
+int endgameDatabase::distance(const quint64 mover, const quint64 opponent) const
+{
+    return (mDistances==nullptr) ? 0 : mDistances[mIndex->rank(mover, opponent)];
+}
+
+///
+/// \brief endgameDatabase::bestMove Best move of a position: the quickest win, else a draw,
+/// else the slowest loss.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Board
+/// \param toMove Side to move
+///
+/// \return Cell index, -1 if the board is not covered or the game is over
+///
+int endgameDatabase::bestMove(const mnkBoard &board, const boardState::player toMove) const
+{
+    if(!covers(board) || board.isOver()){
+        return -1;
+    }
+
+    quint64 mover = 0;
+    quint64 opponent = 0;
+    for(int i=0; i<board.cellCount(); i++){
+        if(board.cell(i)==toMove){
+            mover |= quint64(1) << i;
+        }
+        else if(board.cell(i)!=mnkBoard::EMPTY_CELL){
+            opponent |= quint64(1) << i;
+        }
+    }
+
+    // Rank of a move: wins first and the sooner the better, losses last and the later the better
+    int best = -1;
+    int bestRank = -1;
+    for(int i=0; i<board.cellCount(); i++){
+        const quint64 cell = quint64(1) << i;
+        if((mover | opponent) & cell){
+            continue;
+        }
+
+        // After the move the opponent is the side to move
+        const gameValue reply = value(opponent, mover | cell);
+        const int plies = distance(opponent, mover | cell);
+        const int rank = (reply==LOSS) ? 2*MAX_CELLS + 2 - plies :
+                         (reply==DRAW) ? MAX_CELLS + 1 : plies;
+        if(rank>bestRank){
+            best = i;
+            bestRank = rank;
+        }
+    }
+    return best;
+}
+
+///
+/// \brief endgameDatabase::winLines Every run of winLength cells in a row, column or diagonal
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param rows Board rows
+/// \param cols Board columns
+/// \param winLength Marks in a row needed to win
+///
+/// \return The runs, cells as bits
+///
+QVector<quint64> endgameDatabase::winLines(const int rows, const int cols, const int winLength)
+{
+    static const int DIRECTIONS[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    QVector<quint64> lines;
+
+    for(int r=0; r<rows; r++){
+        for(int c=0; c<cols; c++){
+            for(const int *d : DIRECTIONS){
+                const int endRow = r + d[0]*(winLength - 1);
+                const int endCol = c + d[1]*(winLength - 1);
+                if(endRow<0 || endRow>=rows || endCol<0 || endCol>=cols){
+                    continue;
+                }
+                quint64 line = 0;
+                for(int i=0; i<winLength; i++){
+                    line |= quint64(1) << ((r + d[0]*i)*cols + c + d[1]*i);
+                }
+                lines.append(line);
+            }
+        }
+    }
+    return lines;
+}
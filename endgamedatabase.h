@@ -0,0 +1,116 @@
+#ifndef ENDGAMEDATABASE_H
+#define ENDGAMEDATABASE_H
+
+#include "boardstate.h"
+
+#include <QFile>
+#include <QScopedPointer>
+#include <QString>
+#include <QVector>
+
+class mnkBoard;
+
+///
+/// \brief The endgameDatabase class
+///
+/// Game-theoretic value and distance to the result of every position of
+/// an m,n,k board, solved by tools/retrograde and memory-mapped here, so
+/// a move is a handful of lookups instead of a search.
+///
+/// Positions are seen from the side to move, which has as many marks as
+/// the other side or one fewer, whoever started. positionIndex ranks them
+/// without gaps: layers by marks on the board, then the occupied cells
+/// and the cells of the side to move in the combinatorial number system.
+/// That is about a quarter of the 3^cells naive space.
+///
+/// File layout, little-endian:
+///
+///     32 byte header   "TTTE", version, rows, cols, k, flags, 3 reserved bytes,
+///                      position count (64 bits), 12 reserved bytes
+///     values           2 bits per position (perfectPlay::gameValue order), 4 per byte
+///     distances        1 byte per position, plies to the result, when the flags say so
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class endgameDatabase
+{
+public:
+    static const int MAX_CELLS   = 24;
+    static const int HEADER_SIZE = 32;
+    static const char FILE_MAGIC[4];
+    static const quint8 FILE_VERSION   = 1;
+    static const quint8 HAS_DISTANCES  = 0x01;
+
+    // Same values as perfectPlay::gameValue, NO_VALUE for positions no game reaches
+    enum gameValue {LOSS, DRAW, WIN, NO_VALUE};
+
+    ///
+    /// \brief The positionIndex class, perfect hash of the positions of a board size
+    ///
+    /// Miguel Mota
+    /// Oct 17 2026
+    ///
+    class positionIndex
+    {
+    public:
+        explicit positionIndex(const int cells);
+
+        int cells() const { return mCells; };
+        quint64 size() const { return mOffsets[mCells + 1]; };
+        quint64 layerOffset(const int marks) const { return mOffsets[marks]; };
+        quint64 layerSize(const int marks) const { return mOffsets[marks + 1] - mOffsets[marks]; };
+
+        // The side to move has marks/2 of the marks on the board
+        static int moverMarks(const int marks) { return marks/2; };
+
+        quint64 rank(const quint64 mover, const quint64 opponent) const;
+        void unrank(const quint64 index, quint64 &mover, quint64 &opponent) const;
+
+        quint64 binomial(const int n, const int k) const { return (k<0 || k>n) ? 0 : mBinomial[n][k]; };
+
+    protected:
+        int mCells;
+        quint64 mBinomial[MAX_CELLS + 1][MAX_CELLS + 1];
+        quint64 mOffsets[MAX_CELLS + 2];
+
+        quint64 subsetRank(quint64 subset) const;
+        quint64 subsetUnrank(quint64 rank, const int size, const int universe) const;
+    };
+
+    endgameDatabase();
+    ~endgameDatabase() { close(); };
+
+    bool open(const QString &fileName);
+    void close();
+    bool isOpen() const { return mValues!=nullptr; };
+    QString errorString() const { return mError; };
+
+    int rows() const { return mRows; };
+    int cols() const { return mCols; };
+    int winLength() const { return mWinLength; };
+    bool hasDistances() const { return mDistances!=nullptr; };
+    bool covers(const mnkBoard &board) const;
+
+    // Position from the side to move point of view, cells as bits
+    gameValue value(const quint64 mover, const quint64 opponent) const;
+    int distance(const quint64 mover, const quint64 opponent) const;
+
+    // Quickest win, a draw, or the slowest loss; -1 if the board is not covered or over
+    int bestMove(const mnkBoard &board, const boardState::player toMove) const;
+
+    // Winning lines of a board size, cells as bits
+    static QVector<quint64> winLines(const int rows, const int cols, const int winLength);
+
+protected:
+    QFile mFile;
+    QString mError;
+    int mRows;
+    int mCols;
+    int mWinLength;
+    const uchar *mValues;
+    const uchar *mDistances;
+    QScopedPointer<positionIndex> mIndex;
+};
+
+#endif // ENDGAMEDATABASE_H
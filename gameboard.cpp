@@ -2,6 +2,7 @@
 #include "virtualplayer.h"
 
 #include <QPainter>
+#include <QFontMetricsF>
 #include <QPaintEvent>
 #include <QTimer>
 #include <QMutex>
@@ -11,19 +12,22 @@
 
 const int MAGIC_BOARD_SIZE_X = 333;
 const int MAGIC_BOARD_SIZE_Y = 333;
-const int TOTAL_LINES        = 3;
+const int CLASSIC_LINES      = 3;
+const int CLASSIC_CELL_SIZE  = MAGIC_BOARD_SIZE_X/CLASSIC_LINES; // items are designed for this size
+const int MIN_CELL_SIZE      = 32;
 const int ITEM_SIZE          = 50;
 const int X_LINE_WIDTH       = 10;
 const int BOARD_LINE_WIDTH   = 12;
+const int WIN_LINE_WIDTH     = 5;
 const int HALF_SQ_ANGLE      = 45;
-const int TOTAL_ROWS         = 3;
-const int TOTAL_COLS         = 3;
 const int BLINK_TIME         = 400;
-const int O_VALUE            = 0;
-const int X_VALUE            = 1;
-const int USER_MOVE          = X_VALUE;
-const int THINKING_TIME      = 1000;
+const int O_VALUE            = boardState::O_PLAYER;
+const int X_VALUE            = boardState::X_PLAYER;
+const boardState::player USER_MOVE = boardState::X_PLAYER;
+const boardState::player VIRTUAL_MOVE = boardState::O_PLAYER;
+const int THINKING_TIME      = 1000; // default minimum, the engines are faster than that
 const QString FONT_TYPE      = QStringLiteral("Times");
+const QString THINKING       = QStringLiteral("Thinking ...");
 const QString YOU_WIN        = QStringLiteral("YOU WIN!!!");
 const QString YOU_LOSE       = QStringLiteral("YOU LOSE!!!");
 const QString NO_WINNER      = QStringLiteral("NO WINNER!!!");
@@ -31,6 +35,46 @@ const QString CLICK_TO_PLAY  = QStringLiteral("Click the board to play again..."
 
 gameBoard *gameBoard::mInstance = nullptr;
 QMutex gameBoard::mMutex;
+int gameBoard::mBoardRows = CLASSIC_LINES;
+int gameBoard::mBoardCols = CLASSIC_LINES;
+int gameBoard::mBoardWinLength = CLASSIC_LINES;
+int gameBoard::mMinThinkingTime = THINKING_TIME;
+QString gameBoard::mRecordFile;
+
+///
+/// \brief prepareText Lays out a message once, so painting it is a glyph run blit
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param text Text layout
+/// \param value Message
+/// \param font Message font
+///
+static void prepareText(QStaticText &text, const QString &value, const QFont &font)
+{
+    text.setText(value);
+    text.setTextFormat(Qt::PlainText);
+    text.setPerformanceHint(QStaticText::AggressiveCaching);
+    text.prepare(QTransform(), font);
+}
+
+///
+/// \brief drawTextLine Draws a laid out message with its baseline at y, as drawText does
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param painter Current painter
+/// \param x Left position
+/// \param y Baseline position
+/// \param text Text layout
+/// \param ascent Ascent of the text font
+///
+static void drawTextLine(QPainter &painter, const qreal x, const qreal y, const QStaticText &text, const qreal ascent)
+{
+    painter.drawStaticText(QPointF(x, y - ascent), text);
+}
 
 ///
 /// \brief gameBoard::singleInstance Returns the instance of the gameboard singleton
@@ -49,6 +93,51 @@ gameBoard *gameBoard::singleInstance(QWidget *parent)
     return mInstance;
 }
 
+///
+/// \brief gameBoard::setBoardSize Sets the board geometry, call it before creating the board
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param rows Board rows (m)
+/// \param cols Board columns (n)
+/// \param winLength Marks in a row needed to win (k)
+///
+void gameBoard::setBoardSize(const int rows, const int cols, const int winLength)
+{
+    mBoardRows = qBound(1, rows, mnkBoard::MAX_SIDE);
+    mBoardCols = qBound(1, cols, mnkBoard::MAX_SIDE);
+    mBoardWinLength = qMax(1, winLength);
+}
+
+///
+/// \brief gameBoard::setMinThinkingTime Sets how long, at least, the virtual player shows
+/// it is thinking. Its moves are still computed right away.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param milliseconds Minimum display time, 0 plays the moves as soon as they are ready
+///
+void gameBoard::setMinThinkingTime(const int milliseconds)
+{
+    mMinThinkingTime = qMax(0, milliseconds);
+}
+
+///
+/// \brief gameBoard::setRecordFile Sets the game archive, call it before creating the board.
+/// Only the classic 3 x 3 games are recorded.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param fileName Archive, appended to if it exists, empty for none
+///
+void gameBoard::setRecordFile(const QString &fileName)
+{
+    mRecordFile = fileName;
+}
+
 ///
 /// \brief gameBoard::gameBoard Main constructor
 ///
@@ -60,10 +149,59 @@ gameBoard *gameBoard::singleInstance(QWidget *parent)
 gameBoard::gameBoard(QWidget *parent) : QWidget(parent),
     mTimeToBlink(false), mRectWidth(0), mRectHeight(0),
     mWinningStatus(gameBoard::winnerOption::GAME_IN_PROGRESS),
-    mWinningIndex(-1), mUserWon(false), mBlink(true),mThinking(false)
+    mWinningIndex(-1), mBlink(true),mThinking(false),
+    mSession(mBoardRows, mBoardCols, mBoardWinLength), mMoveRequest(0), mCacheRatio(0.0),
+    mSmallTextFont(FONT_TYPE, 10, QFont::Normal), mGameOverFont(FONT_TYPE, 20, QFont::Bold),
+    mSmallTextAscent(QFontMetricsF(mSmallTextFont).ascent()),
+    mGameOverAscent(QFontMetricsF(mGameOverFont).ascent())
 {
     qDebug() << "game board constructor!";
-    setFixedSize(MAGIC_BOARD_SIZE_X , MAGIC_BOARD_SIZE_Y);
+
+    prepareText(mThinkingText, THINKING, mGameOverFont);
+    prepareText(mYouWinText, YOU_WIN, mGameOverFont);
+    prepareText(mYouLoseText, YOU_LOSE, mGameOverFont);
+    prepareText(mNoWinnerText, NO_WINNER, mGameOverFont);
+    prepareText(mClickToPlayText, CLICK_TO_PLAY, mSmallTextFont);
+
+    connect(&mMoveWatcher, &QFutureWatcher<int>::finished, this, &gameBoard::virtualMoveReady);
+
+    // The classic board keeps its magic size, bigger boards get smaller cells
+    const int cellSize = qMax(MIN_CELL_SIZE, MAGIC_BOARD_SIZE_X/qMax(board().rows(), board().cols()));
+    if(board().rows()==CLASSIC_LINES && board().cols()==CLASSIC_LINES){
+        setFixedSize(MAGIC_BOARD_SIZE_X , MAGIC_BOARD_SIZE_Y);
+    }
+    else{
+        setFixedSize(cellSize*board().cols(), cellSize*board().rows());
+    }
+
+    if(!mRecordFile.isEmpty() && board().isClassic()){
+        mRecorder.reset(new gameRecordWriter);
+        if(!mRecorder->open(mRecordFile)){
+            qWarning() << "games not recorded:" << mRecorder->errorString();
+            mRecorder.reset();
+        }
+    }
+
+    // The user plays first
+    virtualPlayer::singleInstance()->ponder(board());
+}
+
+///
+/// \brief gameBoard::~gameBoard Destructor, cancels the virtual player move in progress
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+gameBoard::~gameBoard()
+{
+    cancelVirtualMove();
+    virtualPlayer::singleInstance()->stopPondering();
+    mMoveWatcher.waitForFinished();
+
+    // The game left on the board, if any
+    recordGame();
+
+    qDebug() << "game board destroyed!";
 }
 
 ///
@@ -73,11 +211,12 @@ gameBoard::gameBoard(QWidget *parent) : QWidget(parent),
 /// Jan 5 2021
 ///
 /// \param painter current painter object
-/// \param rect widget area
+/// \param rect widget area, the gradient spans it
+/// \param boardToItem Maps the widget area to the coordinates the items are drawn in
 ///
-void gameBoard::setDrawColors(QPainter &painter, const QRect &rect) const
+void gameBoard::setDrawColors(QPainter &painter, const QRect &rect, const QTransform &boardToItem) const
 {
-    QLinearGradient gradient(QPointF(1, 1), QPointF(rect.width(), rect.height()));
+    QLinearGradient gradient(boardToItem.map(QPointF(1, 1)), boardToItem.map(QPointF(rect.width(), rect.height())));
     gradient.setColorAt(0.0, Qt::white);
     gradient.setColorAt(1.0, Qt::yellow);
 
@@ -85,7 +224,6 @@ void gameBoard::setDrawColors(QPainter &painter, const QRect &rect) const
     painter.setPen(QPen(Qt::black));
 
     painter.setRenderHint(QPainter::Antialiasing);
-    painter.fillRect(rect,  QBrush(Qt::darkBlue));
 }
 
 ///
@@ -99,9 +237,15 @@ void gameBoard::setDrawColors(QPainter &painter, const QRect &rect) const
 ///
 void gameBoard::drawLines(QPainter &painter, const QRect &rect) const
 {
-    for (int i = 1; i<TOTAL_LINES; i++){
-        painter.drawRect((rect.width()/TOTAL_LINES)*i, 1, BOARD_LINE_WIDTH, rect.height());
-        painter.drawRect(1,(rect.height()/TOTAL_LINES)*i, rect.width(), BOARD_LINE_WIDTH);
+    const int cellWidth = rect.width()/board().cols();
+    const int cellHeight = rect.height()/board().rows();
+    const int lineWidth = qMax(2, (BOARD_LINE_WIDTH*qMin(cellWidth, cellHeight))/CLASSIC_CELL_SIZE);
+
+    for (int i = 1; i<board().cols(); i++){
+        painter.drawRect(cellWidth*i, 1, lineWidth, rect.height());
+    }
+    for (int i = 1; i<board().rows(); i++){
+        painter.drawRect(1, cellHeight*i, rect.width(), lineWidth);
     }
 }
 
@@ -145,40 +289,170 @@ void gameBoard::drawO(QPainter &painter, const int x, const int y) const
 
 ///
 /// \brief gameBoard::drawGame Draws the current elements of the game in the board.
+/// Marks are blitted from their sprites, only in the cells to repaint.
 ///
 /// Miguel Mota
 /// Jan 5 2021
 ///
 /// \param painter Current painter
-/// \param rect widget area
+/// \param dirty Area to repaint
 ///
-void gameBoard::drawGame(QPainter &painter, const QRect &rect) const
-{    
-    int adjustX = ((rect.width()/TOTAL_LINES) - ITEM_SIZE)/2;
-    int adjustY = ((rect.height()/TOTAL_LINES) - ITEM_SIZE)/2;
-
-    // What shall we draw?
-    std::function<void(const int, const int, const int)> f = [&](const int val, const int x, const int y) -> void{
-        if(val==O_VALUE){
-            drawO(painter, x, y);
+void gameBoard::drawGame(QPainter &painter, const QRect &dirty) const
+{
+    // For all the items in the board
+    for(int i=0; i<board().cellCount(); i++){
+        const int val = board().cell(i);
+        if(val==mnkBoard::EMPTY_CELL){
+            continue;
         }
-        else if (val==X_VALUE){
-            drawX(painter, x, y);
+
+        const QRect cell = cellRect(i);
+        if(cell.intersects(dirty)){
+            painter.drawPixmap(cell.topLeft(), (val==O_VALUE) ? mOSprites[i] : mXSprite);
         }
-    };
+    }
+}
 
-    // For all the items in the board
-    int count = 0;
-    for(const QVector<int> &line : mBoardValues){
-        // Draw each line item...
-        f(line[0], adjustX, (rect.height()/TOTAL_LINES)*count + adjustY);
-        f(line[1], ((rect.width()/TOTAL_LINES))+adjustX, (rect.height()/3)*count + adjustY);
-        f(line[2], ((rect.width()/TOTAL_LINES)*2)+adjustX, (rect.height()/3)*count + adjustY);
-
-        count++;
+///
+/// \brief gameBoard::refreshRenderCache Renders the layers that only change with the
+/// widget size or the device pixel ratio: the background with the grid, and the marks.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param ratio Device pixel ratio to render for
+///
+void gameBoard::refreshRenderCache(const qreal ratio)
+{
+    mCacheSize = size();
+    mCacheRatio = ratio;
+
+    mBackground = QPixmap(size()*ratio);
+    mBackground.setDevicePixelRatio(ratio);
+    mBackground.fill(Qt::darkBlue);
+
+    QPainter painter(&mBackground);
+    setDrawColors(painter, rect());
+    drawLines(painter, rect());
+    painter.end();
+
+    mXSprite = renderSprite(X_VALUE, 0, ratio);
+    mOSprites.resize(board().cellCount());
+    for(int i=0; i<board().cellCount(); i++){
+        mOSprites[i] = renderSprite(O_VALUE, i, ratio);
     }
 }
 
+///
+/// \brief gameBoard::renderSprite Renders a mark on a transparent cell
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param value Mark, O_VALUE or X_VALUE
+/// \param index Cell the sprite is for, O's take the board gradient of their cell
+/// \param ratio Device pixel ratio to render for
+///
+/// \return The cell sized sprite
+///
+QPixmap gameBoard::renderSprite(const int value, const int index, const qreal ratio) const
+{
+    const int cellWidth = width()/board().cols();
+    const int cellHeight = height()/board().rows();
+    const int adjust = (CLASSIC_CELL_SIZE - ITEM_SIZE)/2;
+
+    QPixmap sprite(QSize(cellWidth, cellHeight)*ratio);
+    sprite.setDevicePixelRatio(ratio);
+    sprite.fill(Qt::transparent);
+
+    // Items are drawn in classic cell units, and scaled to the actual cells
+    QPainter painter(&sprite);
+    const qreal scale = static_cast<qreal>(qMin(cellWidth, cellHeight))/CLASSIC_CELL_SIZE;
+    if(value==O_VALUE){
+        // The gradient runs across the whole board, seen from this cell
+        const QPointF origin(cellWidth*(index%board().cols()), cellHeight*(index/board().cols()));
+        setDrawColors(painter, rect(), QTransform::fromTranslate(-origin.x(), -origin.y())*QTransform::fromScale(1/scale, 1/scale));
+    }
+    else{
+        // drawX draws in its own frame, the gradient goes with it and is the same in every cell
+        setDrawColors(painter, rect());
+    }
+    painter.scale(scale, scale);
+
+    if(value==O_VALUE){
+        drawO(painter, adjust, adjust);
+    }
+    else{
+        drawX(painter, adjust, adjust);
+    }
+    painter.end();
+
+    return sprite;
+}
+
+///
+/// \brief gameBoard::cellCenter Returns the center of a cell in the last painted area
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param index Cell index
+///
+/// \return Cell center point
+///
+QPointF gameBoard::cellCenter(const int index) const
+{
+    const qreal cellWidth = static_cast<qreal>(mRectWidth/board().cols());
+    const qreal cellHeight = static_cast<qreal>(mRectHeight/board().rows());
+
+    return QPointF(cellWidth*(index%board().cols()) + cellWidth/2, cellHeight*(index/board().cols()) + cellHeight/2);
+}
+
+///
+/// \brief gameBoard::cellRect Returns the area of a cell in the last painted area
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param index Cell index
+///
+/// \return Cell area
+///
+QRect gameBoard::cellRect(const int index) const
+{
+    const int cellWidth = mRectWidth/board().cols();
+    const int cellHeight = mRectHeight/board().rows();
+
+    return QRect(cellWidth*(index%board().cols()), cellHeight*(index/board().cols()), cellWidth, cellHeight);
+}
+
+///
+/// \brief gameBoard::thinkingRect Returns the area covered by the thinking message
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \return Message area, antialiasing margin included
+///
+QRect gameBoard::thinkingRect() const
+{
+    const QPointF topLeft(mRectWidth/2 - 40, mRectHeight/2 - 25 - mGameOverAscent);
+    return QRectF(topLeft, mThinkingText.size()).toAlignedRect().adjusted(-1, -1, 1, 1);
+}
+
+///
+/// \brief gameBoard::messageRect Returns the area covered by the game over messages
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \return Message band, its border included
+///
+QRect gameBoard::messageRect() const
+{
+    return QRect(0, mRectHeight/2 - 31, mRectWidth, 63);
+}
+
 ///
 /// \brief gameBoard::paintEvent Paint event handler
 ///
@@ -192,14 +466,23 @@ void gameBoard::paintEvent(QPaintEvent *event)
     QPainter painter;
     painter.begin(this);
 
-    setDrawColors(painter, event->rect());
-    drawLines(painter, event->rect());
-    drawGame(painter, event->rect());
-
     //Save last rect size
-    mRectWidth = event->rect().width();
-    mRectHeight = event->rect().height();
+    mRectWidth = width();
+    mRectHeight = height();
 
+    // The layers below the marks only change with the size or the screen
+    const qreal ratio = devicePixelRatioF();
+    if(mCacheSize!=size() || !qFuzzyCompare(mCacheRatio, ratio)){
+        refreshRenderCache(ratio);
+    }
+
+    // Only the area asked for is repainted, the painter is clipped to it anyway
+    const QRect dirty = event->rect();
+    painter.drawPixmap(QPointF(dirty.topLeft()), mBackground,
+                       QRectF(QPointF(dirty.topLeft())*ratio, QSizeF(dirty.size())*ratio));
+    drawGame(painter, dirty);
+
+    painter.setRenderHint(QPainter::Antialiasing);
     markWiningMove(painter);
 
     // shall we draw the blinking message?
@@ -211,13 +494,11 @@ void gameBoard::paintEvent(QPaintEvent *event)
     else if(mThinking){
 
         qDebug() << "Thinking...";
-        QFont smallTextFont(FONT_TYPE, 10, QFont::Normal);
-        QFont gameOverFont(FONT_TYPE, 20, QFont::Bold);
 
         // let the user know we are thinking...
-        painter.setFont(gameOverFont);
+        painter.setFont(mGameOverFont);
         painter.setPen(QPen(Qt::cyan));
-        painter.drawText(mRectWidth/2 - 40,  mRectHeight/2 - 25, "Thinking ...");
+        drawTextLine(painter, mRectWidth/2 - 40,  mRectHeight/2 - 25, mThinkingText, mGameOverAscent);
     }
     painter.end();
 }
@@ -228,73 +509,146 @@ void gameBoard::paintEvent(QPaintEvent *event)
 /// Miguel Mota
 /// Jan 5 2021
 ///
-/// \param x (3 x 3) X postion set by the user in the board
-/// \param y (3 x 3) Y postion set by the user in the board
+/// \param x (m x n) X postion set by the user in the board
+/// \param y (m x n) Y postion set by the user in the board
 ///
 void gameBoard::setUserMove(const int x, const int y)
 {
-    if(mBoardValues[y][x]==-1){
-        mBoardValues[y][x]=USER_MOVE;
-
-        // virtual user move code...
-        std::function<void()> makeUserMove = [&]{
-
-            // not thinking anymore...
-            mThinking = false;
-
-            if(mInstance!=nullptr){
-                QWidget* w = dynamic_cast<QWidget*>(mInstance);
-                if(w!=nullptr){
-
-                    virtualPlayer::singleInstance()->makeYourNextMove(mBoardValues);
-
-                    // check status after virtual user moves
-                    if(!getGameStatus()){
-                        qDebug() << "Game Over!!! *";
+    const int index = y*board().cols() + x;
 
-                        // Dow we have a winner?
-                        if(mWinningStatus == winnerOption::COL ||
-                           mWinningStatus == winnerOption::ROW ||
-                           mWinningStatus == winnerOption::DIAG_1 ||
-                           mWinningStatus == winnerOption::DIAG_2){
-                            // Virtual user won!
-                            mUserWon=false;
-                        }
-                    }
-
-                    w->update();
-                }
-            }
-        };
+    if(x>=0 && x<board().cols() && y>=0 && y<board().rows() &&
+       mSession.toMove()==USER_MOVE && mSession.play(index)){
 
         // Now we have to check the game status...
         if(getGameStatus()){
-
-            // lets pretend we need time to think about our next move...
-            mThinking = true;
-            QTimer::singleShot(THINKING_TIME, makeUserMove);
+            update(cellRect(index));
+            startVirtualMove();
         }
         else{
             // Game over!
             qDebug() << "Game Over!!!";
+            update();
+        }
+    }
+    else{
+        qDebug() << "Already filled!";
+    }
+}
 
-            // Dow we have a winner?
-            if(mWinningStatus == winnerOption::COL ||
-               mWinningStatus == winnerOption::ROW ||
-               mWinningStatus == winnerOption::DIAG_1 ||
-               mWinningStatus == winnerOption::DIAG_2){
-                // User won!
-                mUserWon=true;
-            }
+///
+/// \brief gameBoard::startVirtualMove Asks the virtual player for its move on a worker
+/// thread, the board keeps answering while it thinks.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void gameBoard::startVirtualMove()
+{
+    mThinking = true;
+    mMoveRequest++;
+    mThinkingTimer.start();
+
+    mMoveWatcher.setFuture(virtualPlayer::singleInstance()->chooseMoveAsync(board()));
+    update(thinkingRect());
+}
+
+///
+/// \brief gameBoard::virtualMoveReady The virtual player move is ready, it is played once
+/// the minimum thinking time is over.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void gameBoard::virtualMoveReady()
+{
+    if(!mThinking){
+        // cancelled
+        return;
+    }
+
+    const int move = mMoveWatcher.result();
+    const qint64 remaining = mMinThinkingTime - mThinkingTimer.elapsed();
+
+    if(remaining<=0){
+        playVirtualMove(move);
+        return;
+    }
+
+    // lets pretend we need time to think about our next move...
+    const quint64 request = mMoveRequest;
+    QTimer::singleShot(static_cast<int>(remaining), this, [this, move, request]{
+        if(request==mMoveRequest){
+            playVirtualMove(move);
         }
+    });
+}
 
+///
+/// \brief gameBoard::playVirtualMove Plays the virtual player move
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param move Cell index
+///
+void gameBoard::playVirtualMove(const int move)
+{
+    // not thinking anymore...
+    mThinking = false;
+    update(thinkingRect());
+
+    mSession.play(move);
+    update(cellRect(move));
+
+    // check status after virtual user moves
+    if(!getGameStatus()){
+        qDebug() << "Game Over!!! *";
         update();
     }
     else{
-        qDebug() << "Already filled!";
+        // get the replies ready while the user thinks
+        virtualPlayer::singleInstance()->ponder(board());
     }
 }
 
+///
+/// \brief gameBoard::cancelVirtualMove Drops the virtual player move in progress, if any
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void gameBoard::cancelVirtualMove()
+{
+    if(!mThinking){
+        return;
+    }
+
+    mThinking = false;
+    mMoveRequest++;
+    virtualPlayer::singleInstance()->cancelMoves();
+}
+
+///
+/// \brief gameBoard::recordGame Appends the game on the board to the archive, the
+/// outcome as shown to the user. Empty boards are not recorded.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void gameBoard::recordGame()
+{
+    if(mRecorder.isNull() || mSession.moves().empty()){
+        return;
+    }
+
+    // gameRecord::outcome follows the winnerOption order
+    static_assert(static_cast<int>(winnerOption::ROW)==gameRecord::ROW_WIN &&
+                  static_cast<int>(winnerOption::GAME_IN_PROGRESS)==gameRecord::UNFINISHED, "outcome order");
+    gameRecord record = gameRecord::fromSession(mSession);
+    record.result = static_cast<gameRecord::outcome>(mWinningStatus);
+    mRecorder->append(record);
+}
+
 ///
 /// \brief gameBoard::markWiningMove Draws a red line marking the winning game
 ///
@@ -305,31 +659,28 @@ void gameBoard::setUserMove(const int x, const int y)
 ///
 void gameBoard::markWiningMove(QPainter &painter) const
 {
-    painter.setBrush(QBrush(Qt::red));
-    painter.setPen(QPen(Qt::black));
+    if(mWinningStatus == winnerOption::GAME_IN_PROGRESS ||
+       mWinningStatus == winnerOption::BOARD_FULL ||
+       board().winStart()<0){
+        return;
+    }
 
-    switch(mWinningStatus){
-        case winnerOption::COL:
-            painter.drawRect((mRectWidth/TOTAL_LINES)*mWinningIndex + (((mRectWidth/TOTAL_LINES)/2)), 1, 5, mRectHeight);
-            break;
-        case winnerOption::ROW:
-            painter.drawRect(1, (mRectWidth/TOTAL_LINES)*mWinningIndex + (((mRectWidth/TOTAL_LINES)/2)), mRectWidth, 5);
-            break;
-        case winnerOption::DIAG_1:
-            painter.rotate(HALF_SQ_ANGLE);
-            painter.drawRect(1, 1, mRectWidth*2, 5);
-            painter.rotate(-1*HALF_SQ_ANGLE);
-            break;
-        case winnerOption::DIAG_2:
-            painter.translate(1, mRectHeight);
-            painter.rotate(-1*HALF_SQ_ANGLE);
-            painter.drawRect(1, 1, mRectWidth*2, 5);
-            painter.rotate(HALF_SQ_ANGLE);
-            painter.translate(-1, -1*mRectHeight);
-            break;
-        default:
-            break;
-    };
+    // From border to border of the winning cells
+    QPointF start = cellCenter(board().winStart());
+    QPointF end = cellCenter(board().winEnd());
+    const int cells = qMax(qAbs(board().winEnd()%board().cols() - board().winStart()%board().cols()),
+                           qAbs(board().winEnd()/board().cols() - board().winStart()/board().cols()));
+    if(cells>0){
+        const QPointF halfCell = (end - start)/(2*cells);
+        start -= halfCell;
+        end += halfCell;
+    }
+
+    painter.setPen(QPen(Qt::black, WIN_LINE_WIDTH + 2, Qt::SolidLine, Qt::FlatCap));
+    painter.drawLine(start, end);
+    painter.setPen(QPen(Qt::red, WIN_LINE_WIDTH, Qt::SolidLine, Qt::FlatCap));
+    painter.drawLine(start, end);
+    painter.setPen(QPen(Qt::black));
 }
 
 ///
@@ -349,7 +700,7 @@ void gameBoard::showMessages(QPainter &painter)
             QWidget* w = dynamic_cast<QWidget*>(mInstance);
             if(w!=nullptr){
                 mTimeToBlink=true;
-                w->update();
+                w->update(mInstance->messageRect());
             }
         }
     };
@@ -360,26 +711,23 @@ void gameBoard::showMessages(QPainter &painter)
         case winnerOption::DIAG_1:
         case winnerOption::DIAG_2:
             if(mBlink){
-                QFont smallTextFont(FONT_TYPE, 10, QFont::Normal);
-                QFont gameOverFont(FONT_TYPE, 20, QFont::Bold);
-
                 // Display Wining status and game over!
                 painter.setBrush(QBrush(Qt::black));
                 painter.drawRect(1, mRectHeight/2 - 30, mRectWidth, 60);
 
-                painter.setFont(gameOverFont);
-                if(mUserWon){
+                painter.setFont(mGameOverFont);
+                if(mSession.status()==boardState::X_WON){
                    painter.setPen(QPen(Qt::green));
-                   painter.drawText(mRectWidth/2 - 70,  mRectHeight/2, YOU_WIN);
+                   drawTextLine(painter, mRectWidth/2 - 70,  mRectHeight/2, mYouWinText, mGameOverAscent);
                 }
                 else{
                     painter.setPen(QPen(Qt::red));
-                    painter.drawText(mRectWidth/2 - 70,  mRectHeight/2, YOU_LOSE);
+                    drawTextLine(painter, mRectWidth/2 - 70,  mRectHeight/2, mYouLoseText, mGameOverAscent);
                 }
 
                 painter.setPen(QPen(Qt::white));
-                painter.setFont(smallTextFont);
-                painter.drawText(mRectWidth/2 - 80,  mRectHeight/2 + 27, CLICK_TO_PLAY);
+                painter.setFont(mSmallTextFont);
+                drawTextLine(painter, mRectWidth/2 - 80,  mRectHeight/2 + 27, mClickToPlayText, mSmallTextAscent);
             }
 
             mBlink = !mBlink;
@@ -387,20 +735,17 @@ void gameBoard::showMessages(QPainter &painter)
             break;
         case winnerOption::BOARD_FULL:
             if(mBlink){
-                QFont smallTextFont(FONT_TYPE, 10, QFont::Normal);
-                QFont gameOverFont(FONT_TYPE, 20, QFont::Bold);
-
                 // Display Wining status and game over!
                 painter.setBrush(QBrush(Qt::black));
                 painter.drawRect(1, mRectHeight/2 - 30, mRectWidth, 60);
 
-                painter.setFont(gameOverFont);
+                painter.setFont(mGameOverFont);
                 painter.setPen(QPen(Qt::blue));
-                painter.drawText(mRectWidth/2 - 90,  mRectHeight/2, NO_WINNER);
+                drawTextLine(painter, mRectWidth/2 - 90,  mRectHeight/2, mNoWinnerText, mGameOverAscent);
 
                 painter.setPen(QPen(Qt::white));
-                painter.setFont(smallTextFont);
-                painter.drawText(mRectWidth/2 - 80,  mRectHeight/2 + 27, CLICK_TO_PLAY);
+                painter.setFont(mSmallTextFont);
+                drawTextLine(painter, mRectWidth/2 - 80,  mRectHeight/2 + 27, mClickToPlayText, mSmallTextAscent);
             }
 
             mBlink = !mBlink;
@@ -414,6 +759,7 @@ void gameBoard::showMessages(QPainter &painter)
 
 ///
 /// \brief gameBoard::getGameStatus Checks if some user has won, or the board is full, or if game shall continue...
+/// The board keeps its status up to date on every move, here we just translate it.
 ///
 /// Miguel Mota
 /// Jan 5 2021
@@ -422,73 +768,37 @@ void gameBoard::showMessages(QPainter &painter)
 ///
 bool gameBoard::getGameStatus()
 {
-    bool boardFull = true;
-    bool diag1Winner = true;
-    bool diag2Winner = true;
-
-    // Lambda for win verification...
-    std::function<bool(const winnerOption, const bool, const int index)> checkIfWin = [&](const winnerOption wo,
-                                                                          const bool winnerFlag,
-                                                                          const int index) -> bool{
-        if(winnerFlag){
-            mWinningStatus = wo;
-            mWinningIndex = index;
-            return true;
-        }
-        return false;
-    };
-
-    for(int i=0; i<TOTAL_ROWS; i++){
-
-        bool rowWinner = true;
-        bool colWinner = true;
-
-        for(int j=0; j<TOTAL_COLS; j++){
-
-            // check if the board is full
-            if(mBoardValues[i][j]==-1){
-                boardFull=false;
+    switch(board().gameStatus()){
+        case boardState::O_WON:
+        case boardState::X_WON:
+        {
+            // Which kind of line did it?
+            const int rowStep = board().winEnd()/board().cols() - board().winStart()/board().cols();
+            const int colStep = board().winEnd()%board().cols() - board().winStart()%board().cols();
+
+            if(rowStep==0){
+                mWinningStatus = winnerOption::ROW;
+                mWinningIndex = board().winStart()/board().cols();
             }
-
-            // check all the col values for row i
-            // check all the row values for col i
-            if(j>0){
-                if(mBoardValues[i][j]==-1 || mBoardValues[i][j]!=mBoardValues[i][j-1]){
-                    rowWinner=false;
-                }
-
-                if(mBoardValues[j][i]==-1 || mBoardValues[j][i]!=mBoardValues[j-1][i]){
-                    colWinner=false;
-                }
+            else if(colStep==0){
+                mWinningStatus = winnerOption::COL;
+                mWinningIndex = board().winStart()%board().cols();
             }
-
-            // Check 2 diagonals
-            if(i>0 && i==j){
-                if(mBoardValues[i][j]==-1 || mBoardValues[i][j]!=mBoardValues[i-1][j-1]){
-                    diag1Winner=false;
-                }
-
-                if(mBoardValues[i][(TOTAL_COLS-1)-j]==-1 ||
-                   mBoardValues[i][(TOTAL_COLS-1)-j]!=mBoardValues[i-1][((TOTAL_COLS-1)-(j-1))]){
-                    diag2Winner=false;
-                }
+            else{
+                mWinningStatus = (rowStep*colStep>0) ? winnerOption::DIAG_1 : winnerOption::DIAG_2;
+                mWinningIndex = -1;
             }
-        }
-
-        if(checkIfWin(winnerOption::ROW, rowWinner, i) ||
-           checkIfWin(winnerOption::COL, colWinner, i)){
             mTimeToBlink = true;
             return false;
         }
-    }
-
-    if(checkIfWin(winnerOption::DIAG_1, diag1Winner, -1) ||
-       checkIfWin(winnerOption::DIAG_2, diag2Winner, -1) ||
-       checkIfWin(winnerOption::BOARD_FULL, boardFull, -1)
-            ){
-        mTimeToBlink = true;
-        return false;
-    }
+        case boardState::DRAW:
+            mWinningStatus = winnerOption::BOARD_FULL;
+            mWinningIndex = -1;
+            mTimeToBlink = true;
+            return false;
+        case boardState::IN_PROGRESS:
+            break;
+    };
 
     mWinningStatus = winnerOption::GAME_IN_PROGRESS;
     mWinningIndex = -1;
@@ -518,32 +828,25 @@ void gameBoard::mousePressEvent (QMouseEvent *event)
        mWinningStatus == winnerOption::DIAG_2 ||
        mWinningStatus == winnerOption::BOARD_FULL){
 
-        // Clear the board
-        for(QVector<int> &row : mBoardValues){
-            for(int &value : row){
-                value = -1;
-            }
-        }
-
-        // just for some nanoseconds user won if virtual user didn't!
-        if(mWinningStatus == winnerOption::BOARD_FULL){
-            mUserWon=true;
-        }
+        // Clear the board, the winner starts
+        recordGame();
+        cancelVirtualMove();
+        virtualPlayer::singleInstance()->stopPondering();
+        mSession.newGame();
 
         // Restart the game
         mWinningStatus = winnerOption::GAME_IN_PROGRESS;
         mWinningIndex = -1;
         mTimeToBlink = false;
 
-        // If the Virtual user won or nobody won, he starts!
-        // No need to check the status of the game
-        // since the bard is empty an it is no possible to
-        // win with a single move...
-        if(!mUserWon){
-            virtualPlayer::singleInstance()->makeYourNextMove(mBoardValues);
+        // If the Virtual user won, he starts!
+        if(mSession.toMove()==VIRTUAL_MOVE){
+            startVirtualMove();
+        }
+        else{
+            virtualPlayer::singleInstance()->ponder(board());
         }
 
-        mUserWon = false;
         mBlink = true;
 
         update();
@@ -551,18 +854,10 @@ void gameBoard::mousePressEvent (QMouseEvent *event)
         return;
     }
 
-    int ii=-1,jj=-1;
-    for (int i = 0; i<TOTAL_LINES; i++){
-        if(event->pos().x()>(mRectWidth/TOTAL_LINES)*i){
-            ii = i;
-        }
-        if(event->pos().y()>(mRectHeight/TOTAL_LINES)*i){
-            jj = i;
-        }
-    }
+    const int ii = qBound(0, event->pos().x()/qMax(1, mRectWidth/board().cols()), board().cols() - 1);
+    const int jj = qBound(0, event->pos().y()/qMax(1, mRectHeight/board().rows()), board().rows() - 1);
 
     setUserMove(ii, jj);
-    update();
 
     qDebug() << "clicked : " << ii << ", " << jj;
 }
@@ -1,8 +1,18 @@
 #ifndef GAMEBOARD_H
 #define GAMEBOARD_H
 
+#include "gamesession.h"
+#include "gamerecord.h"
+
 #include <QWidget>
 #include <QVector>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+#include <QScopedPointer>
+#include <QPixmap>
+#include <QTransform>
+#include <QFont>
+#include <QStaticText>
 #include <QMutex>
 #include <QMutexLocker>
 #include <QDebug>
@@ -19,9 +29,21 @@ class gameBoard : public QWidget
 {
     Q_OBJECT
 
+    // tools/benchmark times the status checks and the painting
+    friend class gameBoardBenchmark;
+
 public:
     static gameBoard *singleInstance(QWidget *parent);
 
+    // Board geometry for the games to come, m x n cells and k in a row to win
+    static void setBoardSize(const int rows, const int cols, const int winLength);
+
+    // Shortest time the virtual player shows it is thinking, 0 for none
+    static void setMinThinkingTime(const int milliseconds);
+
+    // Archive every 3 x 3 game played to this file, empty for none (default)
+    static void setRecordFile(const QString &fileName);
+
     static void destroySingleton(){
                                     QMutexLocker ml(&mMutex);
                                     if(mInstance!=nullptr){
@@ -40,6 +62,12 @@ protected:
     // Mutex used for protecting mInstance
     // object, used in timer...
     static QMutex mMutex;
+    // Board geometry settings
+    static int mBoardRows;
+    static int mBoardCols;
+    static int mBoardWinLength;
+    static int mMinThinkingTime;
+    static QString mRecordFile;
     //Flag used to avoid
     // blinking timer to be duplicated
     // and get crazy
@@ -53,33 +81,71 @@ protected:
     int mRectHeight;
     winnerOption mWinningStatus;
     int mWinningIndex;
-    bool mUserWon;
     bool mBlink;
     bool mThinking;
-    QVector<QVector<int>> mBoardValues = { {-1 , -1, -1},
-                                           {-1 , -1, -1},
-                                           {-1 , -1, -1} };
+    gameSession mSession;
+
+    // Virtual player move, computed on a worker thread
+    QFutureWatcher<int> mMoveWatcher;
+    QElapsedTimer mThinkingTimer;
+    quint64 mMoveRequest;
+
+    // Game archive, nullptr when not recording
+    QScopedPointer<gameRecordWriter> mRecorder;
+
+    // Render cache: background and grid, the X sprite and one O sprite per cell
+    // (O's take the board gradient where they are), all of them rebuilt when the
+    // size or the device pixel ratio change
+    QPixmap mBackground;
+    QPixmap mXSprite;
+    QVector<QPixmap> mOSprites;
+    QSize mCacheSize;
+    qreal mCacheRatio;
+
+    // Message fonts and text layouts, laid out once
+    QFont mSmallTextFont;
+    QFont mGameOverFont;
+    qreal mSmallTextAscent;
+    qreal mGameOverAscent;
+    QStaticText mThinkingText;
+    QStaticText mYouWinText;
+    QStaticText mYouLoseText;
+    QStaticText mNoWinnerText;
+    QStaticText mClickToPlayText;
+
+    const mnkBoard &board() const { return mSession.board(); };
 
     // Events
     void mousePressEvent (QMouseEvent *event) override;    
 
     // Constructors - Destructors
     gameBoard(QWidget *parent);
-    ~gameBoard() { qDebug() << "game board destroyed!"; };
+    ~gameBoard();
 
     // Drawing methods
     void paintEvent(QPaintEvent *event) override;
     void drawLines(QPainter &painter, const QRect &rect) const;
-    void setDrawColors(QPainter &painter, const QRect &rect) const;
+    void setDrawColors(QPainter &painter, const QRect &rect, const QTransform &boardToItem = QTransform()) const;
     void drawX(QPainter &painter, const int x, const int y) const;
     void drawO(QPainter &painter, const int x, const int y) const;
-    void drawGame(QPainter &painter, const QRect &rect) const;    
+    void drawGame(QPainter &painter, const QRect &dirty) const;
+    void refreshRenderCache(const qreal ratio);
+    QPixmap renderSprite(const int value, const int index, const qreal ratio) const;
+    QPointF cellCenter(const int index) const;
+    QRect cellRect(const int index) const;
+    QRect thinkingRect() const;
+    QRect messageRect() const;
     void markWiningMove(QPainter &painter) const;
     void showMessages(QPainter &painter);
 
     // logic methods
     void setUserMove(const int x, const int y);
     bool getGameStatus();
+    void startVirtualMove();
+    void virtualMoveReady();
+    void playVirtualMove(const int move);
+    void cancelVirtualMove();
+    void recordGame();
 
 };
 
@@ -0,0 +1,444 @@
+#include "gamerecord.h"
+#include "gamesession.h"
+
+#include <QFileInfo>
+
+#include <cstring>
+
+const char gameRecord::FILE_MAGIC[4] = {'T', 'T', 'T', 'R'};
+const int FIRST_PLAYER_BIT = 0x80;
+const int OUTCOME_SHIFT    = 4;
+const int OUTCOME_MASK     = 0x07;
+const int MOVE_COUNT_MASK  = 0x0F;
+
+///
+/// \brief The gameRecordWriter::flusher class, runs the writer loop
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class gameRecordWriter::flusher : public QThread
+{
+public:
+    explicit flusher(gameRecordWriter *writer) : mWriter(writer) {};
+
+protected:
+    gameRecordWriter *mWriter;
+
+    void run() override { mWriter->flushLoop(); };
+};
+
+///
+/// \brief gameRecord::fromSession Record of the game played in a session so far
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param session Classic 3 x 3 game
+///
+/// \return The record
+///
+gameRecord gameRecord::fromSession(const gameSession &session)
+{
+    gameRecord record;
+    record.firstPlayer = session.firstPlayer();
+    record.result = outcomeOf(session.board());
+    record.moveCount = qMin(static_cast<int>(session.moves().size()), MAX_MOVES);
+    for(int i=0; i<record.moveCount; i++){
+        record.moves[i] = static_cast<quint8>(session.moves()[i]);
+    }
+    return record;
+}
+
+///
+/// \brief gameRecord::outcomeOf Outcome of a board, the line kinds as gameBoard tells them apart
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Board
+///
+/// \return The outcome
+///
+gameRecord::outcome gameRecord::outcomeOf(const mnkBoard &board)
+{
+    switch(board.gameStatus()){
+        case boardState::O_WON:
+        case boardState::X_WON:
+        {
+            const int rowStep = board.winEnd()/board.cols() - board.winStart()/board.cols();
+            const int colStep = board.winEnd()%board.cols() - board.winStart()%board.cols();
+
+            if(rowStep==0){
+                return ROW_WIN;
+            }
+            if(colStep==0){
+                return COL_WIN;
+            }
+            return (rowStep*colStep>0) ? DIAG_1_WIN : DIAG_2_WIN;
+        }
+        case boardState::DRAW:
+            return DRAW;
+        case boardState::IN_PROGRESS:
+            break;
+    };
+
+    return UNFINISHED;
+}
+
+///
+/// \brief gameRecord::encode Writes the game in the archive format
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param data Output, room for MAX_SIZE bytes
+///
+/// \return Bytes written
+///
+int gameRecord::encode(char *data) const
+{
+    const int count = qBound(0, moveCount, MAX_MOVES);
+
+    data[0] = static_cast<char>(count | ((result & OUTCOME_MASK) << OUTCOME_SHIFT) |
+                                ((firstPlayer==boardState::O_PLAYER) ? FIRST_PLAYER_BIT : 0));
+    for(int i=0; i<count; i+=2){
+        const int high = (i + 1<count) ? (moves[i + 1] & 0x0F) : 0;
+        data[1 + i/2] = static_cast<char>((moves[i] & 0x0F) | (high << 4));
+    }
+    return encodedSize(count);
+}
+
+///
+/// \brief gameRecord::decode Reads a game in the archive format
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param data Encoded game
+/// \param size Bytes available
+/// \param record Output
+///
+/// \return Bytes used, 0 if the data is not a whole valid game
+///
+int gameRecord::decode(const uchar *data, const qint64 size, gameRecord &record)
+{
+    if(size<1){
+        return 0;
+    }
+
+    const int count = data[0] & MOVE_COUNT_MASK;
+    const int result = (data[0] >> OUTCOME_SHIFT) & OUTCOME_MASK;
+    if(count>MAX_MOVES || result>UNFINISHED || size<encodedSize(count)){
+        return 0;
+    }
+
+    record.firstPlayer = (data[0] & FIRST_PLAYER_BIT) ? boardState::O_PLAYER : boardState::X_PLAYER;
+    record.result = static_cast<outcome>(result);
+    record.moveCount = count;
+    for(int i=0; i<count; i++){
+        record.moves[i] = (data[1 + i/2] >> ((i%2)*4)) & 0x0F;
+    }
+    return encodedSize(count);
+}
+
+///
+/// \brief gameRecordWriter::gameRecordWriter Main constructor, starts the writer thread
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+gameRecordWriter::gameRecordWriter() :
+    mAppended(0), mWritten(0), mStop(false)
+{
+    mFlusher = new flusher(this);
+    mFlusher->start(QThread::LowPriority);
+}
+
+///
+/// \brief gameRecordWriter::~gameRecordWriter Destructor, writes what is left and stops the writer thread
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+gameRecordWriter::~gameRecordWriter()
+{
+    {
+        QMutexLocker ml(&mMutex);
+        mStop = true;
+        mWork.wakeAll();
+    }
+
+    mFlusher->wait();
+    delete mFlusher;
+}
+
+///
+/// \brief gameRecordWriter::open Opens an archive for appending, a new or empty file
+/// gets the file header.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param fileName Archive
+///
+/// \return false on error, see errorString()
+///
+bool gameRecordWriter::open(const QString &fileName)
+{
+    // The writer thread waits for the new file, what is pending goes to the old one
+    QMutexLocker fl(&mFileMutex);
+    QByteArray pending;
+    {
+        QMutexLocker ml(&mMutex);
+        pending.swap(mPending);
+    }
+    writeOut(pending);
+
+    mFile.close();
+    mFile.setFileName(fileName);
+
+    // Never append to something that is not an archive
+    if(QFileInfo(fileName).size()>0){
+        if(!mFile.open(QIODevice::ReadOnly)){
+            mError = mFile.errorString();
+            return false;
+        }
+        const QByteArray header = mFile.read(gameRecord::FILE_HEADER_SIZE);
+        mFile.close();
+        if(header.size()<gameRecord::FILE_HEADER_SIZE || memcmp(header.constData(), gameRecord::FILE_MAGIC, 4)!=0 ||
+           static_cast<quint8>(header[4])!=gameRecord::FILE_VERSION){
+            mError = fileName + QStringLiteral(" is not a game archive");
+            return false;
+        }
+    }
+
+    if(!mFile.open(QIODevice::WriteOnly | QIODevice::Append)){
+        mError = mFile.errorString();
+        return false;
+    }
+    if(mFile.size()==0){
+        char header[gameRecord::FILE_HEADER_SIZE] = {};
+        memcpy(header, gameRecord::FILE_MAGIC, 4);
+        header[4] = static_cast<char>(gameRecord::FILE_VERSION);
+        mFile.write(header, gameRecord::FILE_HEADER_SIZE);
+        mFile.flush();
+    }
+    return true;
+}
+
+///
+/// \brief gameRecordWriter::append Queues a game for the archive, never waits for the disk
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param record Game
+///
+void gameRecordWriter::append(const gameRecord &record)
+{
+    char data[gameRecord::MAX_SIZE];
+    const int size = record.encode(data);
+
+    QMutexLocker ml(&mMutex);
+    const bool wasEmpty = mPending.isEmpty();
+    mPending.append(data, size);
+    mAppended += size;
+    if(wasEmpty){
+        mWork.wakeOne();
+    }
+}
+
+///
+/// \brief gameRecordWriter::flush Waits until every game appended so far is in the file
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void gameRecordWriter::flush()
+{
+    QMutexLocker ml(&mMutex);
+    const quint64 target = mAppended;
+    while(mWritten<target){
+        mFlushed.wait(&mMutex);
+    }
+}
+
+///
+/// \brief gameRecordWriter::flushLoop Writer thread main loop, empties the buffer to the file
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void gameRecordWriter::flushLoop()
+{
+    QByteArray writing;
+
+    while(true){
+        {
+            QMutexLocker ml(&mMutex);
+            while(mPending.isEmpty() && !mStop){
+                mWork.wait(&mMutex);
+            }
+            if(mPending.isEmpty()){
+                return; // stopped, and everything written
+            }
+        }
+
+        // The buffer is taken under the file lock, so open() cannot swap the file
+        // between taking it and writing it. The producers refill the other one meanwhile
+        QMutexLocker fl(&mFileMutex);
+        {
+            QMutexLocker ml(&mMutex);
+            writing.swap(mPending);
+            mPending.clear();
+        }
+        writeOut(writing);
+    }
+}
+
+///
+/// \brief gameRecordWriter::writeOut Writes taken games to the file and counts them as
+/// written, the caller holds the file lock.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param data Encoded games, emptied
+///
+void gameRecordWriter::writeOut(QByteArray &data)
+{
+    if(mFile.isOpen() && !data.isEmpty()){
+        mFile.write(data);
+        mFile.flush();
+    }
+
+    QMutexLocker ml(&mMutex);
+    mWritten += data.size();
+    data.clear();
+    mFlushed.wakeAll();
+}
+
+///
+/// \brief gameRecordReader::open Maps an archive
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param fileName Archive
+///
+/// \return false on error, see errorString()
+///
+bool gameRecordReader::open(const QString &fileName)
+{
+    close();
+    mFile.setFileName(fileName);
+
+    if(!mFile.open(QIODevice::ReadOnly)){
+        mError = mFile.errorString();
+        return false;
+    }
+
+    mSize = mFile.size();
+    mData = (mSize>=gameRecord::FILE_HEADER_SIZE) ? mFile.map(0, mSize) : nullptr;
+    if(mData==nullptr || memcmp(mData, gameRecord::FILE_MAGIC, 4)!=0 || mData[4]!=gameRecord::FILE_VERSION){
+        mError = fileName + QStringLiteral(" is not a game archive");
+        close();
+        return false;
+    }
+
+    rewind();
+    return true;
+}
+
+///
+/// \brief gameRecordReader::close Unmaps the archive
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void gameRecordReader::close()
+{
+    if(mData!=nullptr){
+        mFile.unmap(const_cast<uchar*>(mData));
+    }
+    mFile.close();
+    mData = nullptr;
+    mSize = 0;
+    mPos = 0;
+    mDamaged = false;
+}
+
+///
+/// \brief gameRecordReader::next Reads the next game
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param record Output
+///
+/// \return false at the end of the archive, or at a damaged game (see isDamaged())
+///
+bool gameRecordReader::next(gameRecord &record)
+{
+    if(mData==nullptr || mPos>=mSize){
+        return false;
+    }
+
+    if(!readAt(mPos, record)){
+        mDamaged = true;
+        return false;
+    }
+    return true;
+}
+
+///
+/// \brief gameRecordReader::skip Moves over games, only their header byte is read
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param games Games to move over
+///
+/// \return Games skipped, fewer at the end of the archive or at a damaged game
+///
+qint64 gameRecordReader::skip(const qint64 games)
+{
+    qint64 skipped = 0;
+
+    while(skipped<games && mData!=nullptr && mPos<mSize){
+        const int size = gameRecord::encodedSize(mData[mPos] & MOVE_COUNT_MASK);
+        if((mData[mPos] & MOVE_COUNT_MASK)>gameRecord::MAX_MOVES || mPos + size>mSize){
+            mDamaged = true;
+            break;
+        }
+        mPos += size;
+        skipped++;
+    }
+    return skipped;
+}
+
+///
+/// \brief gameRecordReader::readAt Reads the game at a position
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param position Byte offset of the game, moved past it on success
+/// \param record Output
+///
+/// \return false at the end of the archive or at a damaged game
+///
+bool gameRecordReader::readAt(qint64 &position, gameRecord &record) const
+{
+    if(mData==nullptr || position<gameRecord::FILE_HEADER_SIZE || position>=mSize){
+        return false;
+    }
+
+    const int used = gameRecord::decode(mData + position, mSize - position, record);
+    if(used==0){
+        return false;
+    }
+    position += used;
+    return true;
+}
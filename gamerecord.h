@@ -0,0 +1,146 @@
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+
+#include "boardstate.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QString>
+#include <QThread>
+
+class mnkBoard;
+class gameSession;
+
+///
+/// \brief The gameRecord class
+///
+/// One 3 x 3 game in the binary archive format. Archives start with an
+/// 8 byte file header ("TTTR", format version, 3 reserved bytes), then
+/// the games follow back to back, each one:
+///
+///     1 byte     bits 0-3 move count, bits 4-6 outcome, bit 7 set when O moved first
+///     n/2 bytes  the cells played, 4 bits each, low nibble first
+///
+/// A full game takes 6 bytes. The outcome values are the ones of
+/// gameBoard::winnerOption.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class gameRecord
+{
+public:
+    static const int MAX_MOVES = boardState::TOTAL_CELLS;
+    static const int MAX_SIZE  = 1 + (MAX_MOVES + 1)/2;   // encoded bytes
+    static const int FILE_HEADER_SIZE = 8;
+    static const char FILE_MAGIC[4];
+    static const quint8 FILE_VERSION = 1;
+
+    // Same order as gameBoard::winnerOption
+    enum outcome {ROW_WIN, COL_WIN, DIAG_1_WIN, DIAG_2_WIN, DRAW, UNFINISHED};
+
+    boardState::player firstPlayer = boardState::X_PLAYER;
+    outcome result = UNFINISHED;
+    int moveCount = 0;
+    quint8 moves[MAX_MOVES] = {};
+
+    static gameRecord fromSession(const gameSession &session);
+    static outcome outcomeOf(const mnkBoard &board);
+
+    int encode(char *data) const;
+    static int decode(const uchar *data, const qint64 size, gameRecord &record);
+    static int encodedSize(const int moveCount) { return 1 + (moveCount + 1)/2; };
+};
+
+///
+/// \brief The gameRecordWriter class
+///
+/// Appends games to an archive. append() only copies the encoded game
+/// to a memory buffer, a writer thread empties it to the file, so the
+/// caller never waits for the disk. Thread safe; the games appended
+/// before open() go to the previous archive.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class gameRecordWriter
+{
+public:
+    gameRecordWriter();
+    ~gameRecordWriter();
+
+    // A new file gets the file header, an existing archive is appended to
+    bool open(const QString &fileName);
+    QString errorString() const { return mError; };
+
+    void append(const gameRecord &record);
+    void flush();
+
+protected:
+    class flusher;
+
+    QFile mFile;
+    QString mError;
+    QMutex mFileMutex;   // held for any use of mFile, taken before mMutex
+
+    QByteArray mPending;
+    quint64 mAppended;   // bytes handed to append()
+    quint64 mWritten;    // bytes on their way to the file or there
+    bool mStop;
+    QMutex mMutex;
+    QWaitCondition mWork;
+    QWaitCondition mFlushed;
+
+    flusher *mFlusher;
+
+    void flushLoop();
+    void writeOut(QByteArray &data);
+};
+
+///
+/// \brief The gameRecordReader class
+///
+/// Reads an archive through a memory map, no copy and no per game
+/// allocation, for archives of any number of games. Games have no fixed
+/// size: to share an archive among threads, skip() through it to find
+/// where the shards start, then readAt() each shard.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class gameRecordReader
+{
+public:
+    gameRecordReader() : mData(nullptr), mSize(0), mPos(0), mDamaged(false) {};
+    ~gameRecordReader() { close(); };
+
+    bool open(const QString &fileName);
+    void close();
+    QString errorString() const { return mError; };
+
+    // Next game, false at the end of the archive or at a damaged game
+    bool next(gameRecord &record);
+    void rewind() { mPos = gameRecord::FILE_HEADER_SIZE; mDamaged = false; };
+
+    // Moves over games without decoding them, returns how many were skipped
+    qint64 skip(const qint64 games);
+
+    // Game at a position, which is moved past it. Thread safe, for many readers of one map
+    bool readAt(qint64 &position, gameRecord &record) const;
+
+    bool isDamaged() const { return mDamaged; };
+    qint64 size() const { return mSize; };
+    qint64 position() const { return mPos; };
+
+protected:
+    QFile mFile;
+    QString mError;
+    const uchar *mData;
+    qint64 mSize;
+    qint64 mPos;
+    bool mDamaged;
+};
+
+#endif // GAMERECORD_H
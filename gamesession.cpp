@@ -0,0 +1,69 @@
+#include "gamesession.h"
+
+///
+/// \brief gameSession::gameSession Main constructor, X starts the first game
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param rows Board rows (m)
+/// \param cols Board columns (n)
+/// \param winLength Marks in a row needed to win (k)
+///
+gameSession::gameSession(const int rows, const int cols, const int winLength) :
+    mBoard(rows, cols, winLength),
+    mFirstPlayer(boardState::X_PLAYER),
+    mToMove(boardState::X_PLAYER)
+{
+    mMoves.reserve(mBoard.cellCount());
+}
+
+///
+/// \brief gameSession::play Plays a move for the side to move
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param index Cell index
+///
+/// \return false if the move is not legal, nothing is played then
+///
+bool gameSession::play(const int index)
+{
+    if(!mBoard.isLegal(index)){
+        return false;
+    }
+
+    mBoard.play(index, mToMove);
+    mMoves.push_back(index);
+    mToMove = (mToMove==boardState::X_PLAYER) ? boardState::O_PLAYER : boardState::X_PLAYER;
+    return true;
+}
+
+///
+/// \brief gameSession::newGame Clears the board, the winner of the last game starts
+/// and X starts after a draw.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void gameSession::newGame()
+{
+    newGame((mBoard.gameStatus()==boardState::O_WON) ? boardState::O_PLAYER : boardState::X_PLAYER);
+}
+
+///
+/// \brief gameSession::newGame Clears the board
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param first Side playing the first move
+///
+void gameSession::newGame(const boardState::player first)
+{
+    mBoard.clear();
+    mMoves.clear();
+    mFirstPlayer = first;
+    mToMove = first;
+}
@@ -0,0 +1,44 @@
+#ifndef GAMESESSION_H
+#define GAMESESSION_H
+
+#include "mnkboard.h"
+
+#include <vector>
+
+///
+/// \brief The gameSession class
+///
+/// Game rules without any display: whose turn it is, legal moves, game
+/// over, and who starts the next game. The winner of a game starts the
+/// next one, X starts after a draw. Used by the game board widget and
+/// by the headless tools.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class gameSession
+{
+public:
+    gameSession(const int rows = 3, const int cols = 3, const int winLength = 3);
+
+    const mnkBoard &board() const { return mBoard; };
+    boardState::player toMove() const { return mToMove; };
+    boardState::player firstPlayer() const { return mFirstPlayer; };
+    boardState::status status() const { return mBoard.gameStatus(); };
+    bool isOver() const { return mBoard.isOver(); };
+
+    // Cells played in this game, in order
+    const std::vector<int> &moves() const { return mMoves; };
+
+    bool play(const int index);
+    void newGame();
+    void newGame(const boardState::player first);
+
+protected:
+    mnkBoard mBoard;
+    boardState::player mFirstPlayer;
+    boardState::player mToMove;
+    std::vector<int> mMoves;
+};
+
+#endif // GAMESESSION_H
@@ -0,0 +1,172 @@
+#include "inferencecache.h"
+
+const int     PROBE_LIMIT     = 8;  // slots looked at before giving up
+const int     NO_MOVE         = 0xFF;
+const quint32 HASH_MULTIPLIER = 0x9E3779B1u;
+
+///
+/// \brief inferenceCache::inferenceCache Constructor
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param capacity Number of entries, rounded up to a power of 2
+///
+inferenceCache::inferenceCache(const int capacity) : mMask(0), mHits(0), mMisses(0), mEntries(0)
+{
+    int size = PROBE_LIMIT;
+    while(size<capacity){
+        size *= 2;
+    }
+    mMask = static_cast<quint32>(size - 1);
+
+    const entry empty = {};
+    mTable.fill(empty, size);
+}
+
+///
+/// \brief inferenceCache::lookup Looks for the results of a board
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Board to look for
+/// \param network Network the results come from
+/// \param scores Output, TOTAL_CELLS scores in the frame of board
+/// \param move Output, best move in the frame of board
+///
+/// \return true on a hit, scores and move are only written then
+///
+bool inferenceCache::lookup(const boardState &board, const int network, double *scores, int *move)
+{
+    int symmetry = 0;
+    const quint32 key = cacheKey(board, network, &symmetry);
+
+    QMutexLocker ml(&mMutex);
+
+    const int home = slotOf(key);
+    for(int p=0; p<PROBE_LIMIT; p++){
+        const entry &e = mTable[(home + p) & mMask];
+        if(e.key==key){
+            // Cell i of the board is cell SYMMETRIES[symmetry][i] of the canonical one
+            for(int i=0; i<TOTAL_CELLS; i++){
+                scores[i] = e.scores[boardState::SYMMETRIES[symmetry][i]];
+            }
+            *move = (e.move==NO_MOVE) ? -1 : boardState::SYMMETRIES[boardState::INVERSE_SYMMETRY[symmetry]][e.move];
+            mHits++;
+            return true;
+        }
+        if(e.key==0){
+            break;
+        }
+    }
+
+    mMisses++;
+    return false;
+}
+
+///
+/// \brief inferenceCache::insert Stores the results of a board
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Scored board
+/// \param network Network the results come from
+/// \param scores TOTAL_CELLS scores in the frame of board
+/// \param move Best move in the frame of board, -1 if none
+///
+void inferenceCache::insert(const boardState &board, const int network, const double *scores, const int move)
+{
+    int symmetry = 0;
+    const quint32 key = cacheKey(board, network, &symmetry);
+
+    QMutexLocker ml(&mMutex);
+
+    const int home = slotOf(key);
+    entry *slot = &mTable[home];
+    for(int p=0; p<PROBE_LIMIT; p++){
+        entry &e = mTable[(home + p) & mMask];
+        if(e.key==key){
+            return;
+        }
+        if(e.key==0){
+            slot = &e;
+            mEntries++;
+            break;
+        }
+    }
+
+    slot->key = key;
+    slot->move = static_cast<quint8>((move<0) ? NO_MOVE : boardState::SYMMETRIES[symmetry][move]);
+    for(int i=0; i<TOTAL_CELLS; i++){
+        slot->scores[boardState::SYMMETRIES[symmetry][i]] = scores[i];
+    }
+}
+
+///
+/// \brief inferenceCache::clear Forgets every entry, the counters are kept
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void inferenceCache::clear()
+{
+    QMutexLocker ml(&mMutex);
+
+    const entry empty = {};
+    mTable.fill(empty);
+    mEntries = 0;
+}
+
+///
+/// \brief inferenceCache::stats Hit and miss counters
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \return Counters and table use
+///
+inferenceCache::cacheStats inferenceCache::stats() const
+{
+    QMutexLocker ml(&mMutex);
+
+    cacheStats retVal;
+    retVal.hits = mHits;
+    retVal.misses = mMisses;
+    retVal.entries = mEntries;
+    retVal.capacity = mTable.size();
+    return retVal;
+}
+
+///
+/// \brief inferenceCache::cacheKey Key of a board in the table
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Board
+/// \param network Network the results come from
+/// \param symmetry Output, symmetry taking the board to its canonical frame
+///
+/// \return Canonical key with the network above it, plus 1
+///
+quint32 inferenceCache::cacheKey(const boardState &board, const int network, int *symmetry)
+{
+    return (board.canonicalKey(symmetry) | (static_cast<quint32>(network) << (2*TOTAL_CELLS))) + 1;
+}
+
+///
+/// \brief inferenceCache::slotOf Home slot of a key
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param key Table key
+///
+/// \return Slot index
+///
+int inferenceCache::slotOf(const quint32 key) const
+{
+    return static_cast<int>(((key*HASH_MULTIPLIER) >> 8) & mMask);
+}
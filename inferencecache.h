@@ -0,0 +1,66 @@
+#ifndef INFERENCECACHE_H
+#define INFERENCECACHE_H
+
+#include "boardstate.h"
+
+#include <QVector>
+#include <QMutex>
+
+///
+/// \brief The inferenceCache class
+///
+/// Network results by board, shared by every rotated or reflected copy
+/// of a position. Entries are keyed by the canonical board (the smallest
+/// key under the 8 symmetries of the square) and keep the move scores
+/// and the best move in the canonical frame; lookups map them back to
+/// the frame of the asked board.
+///
+/// Fixed size open addressing table with linear probing. When every slot
+/// of a probe run is taken the home slot is overwritten, the table never
+/// grows. Thread safe.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class inferenceCache
+{
+public:
+    static const int TOTAL_CELLS = boardState::TOTAL_CELLS;
+
+    struct cacheStats {
+        quint64 hits   = 0;
+        quint64 misses = 0;
+        int entries    = 0;
+        int capacity   = 0;
+
+        double hitRate() const { return (hits + misses==0) ? 0.00 : static_cast<double>(hits)/(hits + misses); };
+    };
+
+    explicit inferenceCache(const int capacity);
+
+    // network tells apart the results of different networks for the same board
+    bool lookup(const boardState &board, const int network, double *scores, int *move);
+    void insert(const boardState &board, const int network, const double *scores, const int move);
+
+    void clear();
+    cacheStats stats() const;
+
+protected:
+    struct entry {
+        quint32 key;  // canonical key + 1, 0 for an empty slot
+        quint8 move;  // in the canonical frame
+        double scores[TOTAL_CELLS];
+    };
+
+    QVector<entry> mTable;
+    quint32 mMask;
+    quint64 mHits;
+    quint64 mMisses;
+    int mEntries;
+    mutable QMutex mMutex;
+
+    static quint32 cacheKey(const boardState &board, const int network, int *symmetry);
+    int slotOf(const quint32 key) const;
+};
+
+#endif // INFERENCECACHE_H
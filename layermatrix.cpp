@@ -0,0 +1,208 @@
+#include "layermatrix.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+const int LANE_PADDING  = 4;  // doubles per AVX2 register
+const int BOARD_BLOCK   = 4;  // boards sharing each weight load
+
+///
+/// \brief layerMatrix::layerMatrix Default constructor, empty layer
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+layerMatrix::layerMatrix() : mInputs(0), mOutputs(0), mStride(0), mExternal(nullptr)
+{
+}
+
+///
+/// \brief layerMatrix::layerMatrix Builds the padded layout from the theta values
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param theta Theta values, one row per output neuron, one column per input.
+///
+layerMatrix::layerMatrix(const QVector<QVector<double>> &theta) :
+    mInputs(theta.isEmpty() ? 0 : theta.first().size()),
+    mOutputs(theta.size()),
+    mStride(paddedSize(theta.size())),
+    mExternal(nullptr)
+{
+    mValues.fill(0.00, mInputs*mStride);
+
+    // Transpose, so the neurons of each input are contiguous...
+    for(int i=0; i<mOutputs; i++){
+        for(int j=0; j<mInputs && j<theta[i].size(); j++){
+            mValues[j*mStride + i] = theta[i][j];
+        }
+    }
+}
+
+///
+/// \brief layerMatrix::layerMatrix Builds the padded layout from a plain theta array
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param theta outputs x inputs theta values, row-major
+/// \param outputs Number of output neurons
+/// \param inputs Number of inputs, bias included
+///
+layerMatrix::layerMatrix(const double *theta, const int outputs, const int inputs) :
+    mInputs(inputs),
+    mOutputs(outputs),
+    mStride(paddedSize(outputs)),
+    mExternal(nullptr)
+{
+    mValues.fill(0.00, mInputs*mStride);
+
+    for(int i=0; i<mOutputs; i++){
+        for(int j=0; j<mInputs; j++){
+            mValues[j*mStride + i] = theta[i*mInputs + j];
+        }
+    }
+}
+
+///
+/// \brief layerMatrix::view Wraps values already in the padded, transposed layout.
+/// Nothing is copied, the values must outlive the layer and all its copies.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param values inputs rows of paddedSize(outputs) values
+/// \param inputs Number of inputs, bias included
+/// \param outputs Number of output neurons
+///
+/// \return The layer
+///
+layerMatrix layerMatrix::view(const double *values, const int inputs, const int outputs)
+{
+    layerMatrix retVal;
+    retVal.mInputs = inputs;
+    retVal.mOutputs = outputs;
+    retVal.mStride = paddedSize(outputs);
+    retVal.mExternal = values;
+    return retVal;
+}
+
+///
+/// \brief layerMatrix::paddedSize Rounds a row size up to the vector lane multiple
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param size Number of values in the row
+/// \return Padded number of values
+///
+int layerMatrix::paddedSize(const int size)
+{
+    return ((size + LANE_PADDING - 1)/LANE_PADDING)*LANE_PADDING;
+}
+
+///
+/// \brief layerMatrix::multiply Batched matrix product, output = input * theta'.
+/// Neuron activation is not applied here.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param input batchSize rows of inputs() values, inputStride values apart
+/// \param inputStride Distance between two input rows
+/// \param batchSize Number of rows to evaluate
+/// \param output batchSize rows of at least stride() values, outputStride values apart.
+/// Padding columns are overwritten with zeroes.
+/// \param outputStride Distance between two output rows
+///
+void layerMatrix::multiply(const double *input, const int inputStride, const int batchSize,
+                           double *output, const int outputStride) const
+{
+    const double *theta = values();
+    int b = 0;
+
+#if defined(__AVX2__)
+    // 4 boards x 4 neurons per step, every weight load is reused 4 times
+    for(; b+BOARD_BLOCK<=batchSize; b+=BOARD_BLOCK){
+        const double *in0 = input + (b+0)*inputStride;
+        const double *in1 = input + (b+1)*inputStride;
+        const double *in2 = input + (b+2)*inputStride;
+        const double *in3 = input + (b+3)*inputStride;
+
+        for(int n=0; n<mStride; n+=4){
+            __m256d acc0 = _mm256_setzero_pd();
+            __m256d acc1 = _mm256_setzero_pd();
+            __m256d acc2 = _mm256_setzero_pd();
+            __m256d acc3 = _mm256_setzero_pd();
+
+            for(int k=0; k<mInputs; k++){
+                const __m256d w = _mm256_loadu_pd(theta + k*mStride + n);
+#if defined(__FMA__)
+                acc0 = _mm256_fmadd_pd(_mm256_set1_pd(in0[k]), w, acc0);
+                acc1 = _mm256_fmadd_pd(_mm256_set1_pd(in1[k]), w, acc1);
+                acc2 = _mm256_fmadd_pd(_mm256_set1_pd(in2[k]), w, acc2);
+                acc3 = _mm256_fmadd_pd(_mm256_set1_pd(in3[k]), w, acc3);
+#else
+                acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_set1_pd(in0[k]), w));
+                acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_set1_pd(in1[k]), w));
+                acc2 = _mm256_add_pd(acc2, _mm256_mul_pd(_mm256_set1_pd(in2[k]), w));
+                acc3 = _mm256_add_pd(acc3, _mm256_mul_pd(_mm256_set1_pd(in3[k]), w));
+#endif
+            }
+
+            _mm256_storeu_pd(output + (b+0)*outputStride + n, acc0);
+            _mm256_storeu_pd(output + (b+1)*outputStride + n, acc1);
+            _mm256_storeu_pd(output + (b+2)*outputStride + n, acc2);
+            _mm256_storeu_pd(output + (b+3)*outputStride + n, acc3);
+        }
+    }
+#elif defined(__SSE2__)
+    // 4 boards x 2 neurons per step
+    for(; b+BOARD_BLOCK<=batchSize; b+=BOARD_BLOCK){
+        const double *in0 = input + (b+0)*inputStride;
+        const double *in1 = input + (b+1)*inputStride;
+        const double *in2 = input + (b+2)*inputStride;
+        const double *in3 = input + (b+3)*inputStride;
+
+        for(int n=0; n<mStride; n+=2){
+            __m128d acc0 = _mm_setzero_pd();
+            __m128d acc1 = _mm_setzero_pd();
+            __m128d acc2 = _mm_setzero_pd();
+            __m128d acc3 = _mm_setzero_pd();
+
+            for(int k=0; k<mInputs; k++){
+                const __m128d w = _mm_loadu_pd(theta + k*mStride + n);
+                acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_set1_pd(in0[k]), w));
+                acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_set1_pd(in1[k]), w));
+                acc2 = _mm_add_pd(acc2, _mm_mul_pd(_mm_set1_pd(in2[k]), w));
+                acc3 = _mm_add_pd(acc3, _mm_mul_pd(_mm_set1_pd(in3[k]), w));
+            }
+
+            _mm_storeu_pd(output + (b+0)*outputStride + n, acc0);
+            _mm_storeu_pd(output + (b+1)*outputStride + n, acc1);
+            _mm_storeu_pd(output + (b+2)*outputStride + n, acc2);
+            _mm_storeu_pd(output + (b+3)*outputStride + n, acc3);
+        }
+    }
+#endif
+
+    // Scalar fallback, and the remaining boards of the batch
+    for(; b<batchSize; b++){
+        const double *in = input + b*inputStride;
+        double *out = output + b*outputStride;
+
+        for(int n=0; n<mStride; n++){
+            out[n] = 0.00;
+        }
+        for(int k=0; k<mInputs; k++){
+            const double *w = theta + k*mStride;
+            for(int n=0; n<mStride; n++){
+                out[n] += in[k]*w[n];
+            }
+        }
+    }
+}
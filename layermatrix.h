@@ -0,0 +1,49 @@
+#ifndef LAYERMATRIX_H
+#define LAYERMATRIX_H
+
+#include <QVector>
+
+///
+/// \brief The layerMatrix class
+///
+/// Dense neural network layer stored as a contiguous, padded,
+/// row-major matrix. The theta values are kept transposed (one row
+/// per input, one column per output neuron) so the batched product
+/// can be vectorized across neurons with AVX2/SSE2, falling back to
+/// plain scalar code when neither is available.
+///
+/// A layer either owns its values or views an already padded block
+/// owned by someone else, like a memory-mapped model file.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class layerMatrix
+{
+public:
+    layerMatrix();
+    explicit layerMatrix(const QVector<QVector<double>> &theta);
+    layerMatrix(const double *theta, const int outputs, const int inputs);
+
+    static layerMatrix view(const double *values, const int inputs, const int outputs);
+
+    int inputs() const { return mInputs; };
+    int outputs() const { return mOutputs; };
+    int stride() const { return mStride; };
+    const double *row(const int input) const { return values() + input*mStride; };
+    const double *values() const { return (mExternal!=nullptr) ? mExternal : mValues.constData(); };
+
+    void multiply(const double *input, const int inputStride, const int batchSize,
+                  double *output, const int outputStride) const;
+
+    static int paddedSize(const int size);
+
+protected:
+    int mInputs;
+    int mOutputs;
+    int mStride;
+    QVector<double> mValues;
+    const double *mExternal; // not owned, nullptr when mValues holds the layer
+};
+
+#endif // LAYERMATRIX_H
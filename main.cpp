@@ -1,7 +1,10 @@
 
 #include "window.h"
+#include "gameboard.h"
+#include "virtualplayer.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QDebug>
 
 /*
@@ -19,7 +22,7 @@
 ///
 class ticTacToeApp: public QApplication {
 public:
-   ticTacToeApp(int argc, char *argv[]) : QApplication(argc, argv){
+   ticTacToeApp(int &argc, char *argv[]) : QApplication(argc, argv){
    }
 
     ~ticTacToeApp() {
@@ -43,6 +46,63 @@ int main(int argc, char *argv[])
 
     qDebug() << "App started!";
 
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("My TicTacToe in QT!"));
+    parser.addHelpOption();
+    QCommandLineOption engineOption(QStringLiteral("engine"),
+                                    QStringLiteral("Virtual player engine: network, quantized, table, negamax or mcts."),
+                                    QStringLiteral("name"), QStringLiteral("network"));
+    QCommandLineOption rowsOption(QStringLiteral("rows"), QStringLiteral("Board rows (m), up to 19."),
+                                  QStringLiteral("m"), QStringLiteral("3"));
+    QCommandLineOption colsOption(QStringLiteral("cols"), QStringLiteral("Board columns (n), up to 19."),
+                                  QStringLiteral("n"), QStringLiteral("3"));
+    QCommandLineOption winOption(QStringLiteral("k"), QStringLiteral("Marks in a row needed to win."),
+                                 QStringLiteral("k"), QStringLiteral("3"));
+    QCommandLineOption timeOption(QStringLiteral("time"),
+                                  QStringLiteral("Time budget per move for the Monte Carlo engine, in ms."),
+                                  QStringLiteral("ms"), QStringLiteral("1000"));
+    QCommandLineOption thinkingOption(QStringLiteral("thinking-time"),
+                                      QStringLiteral("Shortest time the virtual player shows it is thinking, in ms."),
+                                      QStringLiteral("ms"), QStringLiteral("1000"));
+    QCommandLineOption ponderOption(QStringLiteral("ponder"),
+                                    QStringLiteral("Threads preparing the replies while the user thinks, 0 for none."),
+                                    QStringLiteral("threads"), QStringLiteral("0"));
+    QCommandLineOption modelOption(QStringLiteral("model"),
+                                   QStringLiteral("Binary network model, see tools/modelconvert."),
+                                   QStringLiteral("file"));
+    QCommandLineOption endgameOption(QStringLiteral("endgame"),
+                                     QStringLiteral("Endgame database for bigger boards, see tools/retrograde."),
+                                     QStringLiteral("file"));
+    QCommandLineOption recordOption(QStringLiteral("record"),
+                                    QStringLiteral("Append every 3 x 3 game to this archive, see tools/replay."),
+                                    QStringLiteral("file"));
+    parser.addOption(engineOption);
+    parser.addOption(modelOption);
+    parser.addOption(timeOption);
+    parser.addOption(thinkingOption);
+    parser.addOption(ponderOption);
+    parser.addOption(rowsOption);
+    parser.addOption(colsOption);
+    parser.addOption(winOption);
+    parser.addOption(recordOption);
+    parser.addOption(endgameOption);
+    parser.process(app);
+
+    virtualPlayer::singleInstance()->setEngine(virtualPlayer::engineFromName(parser.value(engineOption)));
+    if(parser.isSet(modelOption)){
+        virtualPlayer::singleInstance()->loadModel(parser.value(modelOption));
+    }
+    if(parser.isSet(endgameOption)){
+        virtualPlayer::singleInstance()->loadEndgame(parser.value(endgameOption));
+    }
+    virtualPlayer::singleInstance()->setTimeBudget(parser.value(timeOption).toInt());
+    virtualPlayer::singleInstance()->setPonderThreads(parser.value(ponderOption).toInt());
+    gameBoard::setMinThinkingTime(parser.value(thinkingOption).toInt());
+    gameBoard::setRecordFile(parser.value(recordOption));
+    gameBoard::setBoardSize(parser.value(rowsOption).toInt(),
+                            parser.value(colsOption).toInt(),
+                            parser.value(winOption).toInt());
+
     window::singleInstance()->show();
 
     return app.exec();
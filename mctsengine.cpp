@@ -0,0 +1,424 @@
+#include "mctsengine.h"
+
+#include <QElapsedTimer>
+#include <QDateTime>
+
+#include <cmath>
+
+const int    ITERATIONS_PER_BATCH = 32;
+const int    BATCHES_PER_THREAD   = 2;
+const int    NEIGHBOURHOOD        = 2;    // cells searched around the marks on big boards
+const double EXPLORATION          = 1.41; // UCT constant
+const int    WIN_POINTS           = 2;
+const int    DRAW_POINTS          = 1;
+
+///
+/// \brief nextRandom xorshift64* generator, one state per batch
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param state Generator state, never 0
+///
+/// \return Next random value
+///
+static inline quint64 nextRandom(quint64 &state)
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+///
+/// \brief opponentOf Returns the other player
+///
+static inline boardState::player opponentOf(const boardState::player p)
+{
+    return (p==boardState::X_PLAYER) ? boardState::O_PLAYER : boardState::X_PLAYER;
+}
+
+///
+/// \brief mctsEngine::mctsEngine Main constructor, the node pool is allocated on the first search
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param pool Workers for the search
+/// \param nodeCapacity Maximum number of nodes in the tree
+///
+mctsEngine::mctsEngine(workStealingPool *pool, const int nodeCapacity) :
+    mPool(pool), mNodeCapacity(qMax(2, nodeCapacity)), mNodeCount(0), mRollouts(0),
+    mTimeBudget(DEFAULT_TIME_BUDGET), mCancelled(nullptr)
+{
+}
+
+///
+/// \brief mctsEngine::initNode Resets a node taken from the pool
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param index Node index
+/// \param move Move leading to the node
+///
+void mctsEngine::initNode(const int index, const int move)
+{
+    node &n = mNodes[index];
+    n.visits.store(0, std::memory_order_relaxed);
+    n.score.store(0, std::memory_order_relaxed);
+    n.virtualLoss.store(0, std::memory_order_relaxed);
+    n.state.store(UNEXPANDED, std::memory_order_relaxed);
+    n.firstChild = -1;
+    n.childCount = 0;
+    n.move = move;
+}
+
+///
+/// \brief mctsEngine::expand Creates the children of a node. Only one thread expands each
+/// node, the others keep going with a rollout from it.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param index Node index
+/// \param board Board at the node
+///
+/// \return true if the node has children now
+///
+bool mctsEngine::expand(const int index, const mnkBoard &board)
+{
+    node &n = mNodes[index];
+    int expected = UNEXPANDED;
+
+    if(!n.state.compare_exchange_strong(expected, EXPANDING, std::memory_order_acquire)){
+        return expected==EXPANDED;
+    }
+
+    // Candidate moves, on big boards only close to the marks
+    const bool nearMarksOnly = board.cellCount()>boardState::TOTAL_CELLS && board.moveCount()>0;
+    int moves[mnkBoard::MAX_CELLS];
+    int total = 0;
+
+    for(int i=0; i<board.cellCount(); i++){
+        if(!board.isLegal(i)){
+            continue;
+        }
+
+        bool candidate = !nearMarksOnly;
+        const int row = i/board.cols();
+        const int col = i%board.cols();
+        for(int r=qMax(0, row-NEIGHBOURHOOD); r<=qMin(board.rows()-1, row+NEIGHBOURHOOD) && !candidate; r++){
+            for(int c=qMax(0, col-NEIGHBOURHOOD); c<=qMin(board.cols()-1, col+NEIGHBOURHOOD) && !candidate; c++){
+                candidate = board.cell(r, c)!=mnkBoard::EMPTY_CELL;
+            }
+        }
+
+        if(candidate){
+            moves[total++] = i;
+        }
+    }
+
+    // Empty board, big boards start in the center
+    if(total==0){
+        moves[total++] = (board.rows()/2)*board.cols() + board.cols()/2;
+    }
+
+    const int first = mNodeCount.fetch_add(total, std::memory_order_relaxed);
+    if(first + total>mNodeCapacity){
+        // Pool exhausted, this node stays a leaf
+        n.state.store(LEAF, std::memory_order_release);
+        return false;
+    }
+
+    for(int i=0; i<total; i++){
+        initNode(first + i, moves[i]);
+    }
+    n.firstChild = first;
+    n.childCount = total;
+    n.state.store(EXPANDED, std::memory_order_release);
+
+    return true;
+}
+
+///
+/// \brief mctsEngine::selectChild UCT selection. Virtual losses count as visits
+/// without points, so workers in flight make a branch look worse.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param index Expanded node index
+///
+/// \return Selected child index
+///
+int mctsEngine::selectChild(const int index) const
+{
+    const node &n = mNodes[index];
+    const double parentVisits = n.visits.load(std::memory_order_relaxed) +
+                                n.virtualLoss.load(std::memory_order_relaxed) + 1;
+    const double logParent = std::log(parentVisits);
+    int retVal = n.firstChild;
+    double bestValue = -1.00;
+
+    for(int i=n.firstChild; i<n.firstChild + n.childCount; i++){
+        const node &child = mNodes[i];
+        const int visits = child.visits.load(std::memory_order_relaxed) +
+                           child.virtualLoss.load(std::memory_order_relaxed);
+        if(visits==0){
+            return i;
+        }
+
+        const double value = child.score.load(std::memory_order_relaxed)/(static_cast<double>(WIN_POINTS)*visits) +
+                             EXPLORATION*std::sqrt(logParent/visits);
+        if(value>bestValue){
+            bestValue = value;
+            retVal = i;
+        }
+    }
+
+    return retVal;
+}
+
+///
+/// \brief mctsEngine::iterate One selection, expansion, rollout and backpropagation
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Board at the root, it is played on
+/// \param toMove Side to move at the root
+/// \param rng Random generator state
+///
+void mctsEngine::iterate(mnkBoard &board, const boardState::player toMove, quint64 &rng)
+{
+    int path[mnkBoard::MAX_CELLS + 1];
+    int depth = 0;
+    int current = 0;
+    boardState::player p = toMove;
+
+    path[depth++] = current;
+
+    // Selection, down to a leaf
+    while(!board.isOver()){
+        node &n = mNodes[current];
+        if(n.state.load(std::memory_order_acquire)!=EXPANDED){
+            // Expand nodes that were visited before, then step into a child
+            if(n.visits.load(std::memory_order_relaxed)==0 || !expand(current, board)){
+                break;
+            }
+        }
+
+        current = selectChild(current);
+        mNodes[current].virtualLoss.fetch_add(1, std::memory_order_relaxed);
+        board.play(mNodes[current].move, p);
+        path[depth++] = current;
+        p = opponentOf(p);
+    }
+
+    // Random rollout
+    int empty[mnkBoard::MAX_CELLS];
+    int totalEmpty = 0;
+    if(!board.isOver()){
+        for(int i=0; i<board.cellCount(); i++){
+            if(board.cell(i)==mnkBoard::EMPTY_CELL){
+                empty[totalEmpty++] = i;
+            }
+        }
+    }
+    while(!board.isOver() && totalEmpty>0){
+        const int pick = static_cast<int>(nextRandom(rng) % totalEmpty);
+        board.play(empty[pick], p);
+        empty[pick] = empty[--totalEmpty];
+        p = opponentOf(p);
+    }
+    mRollouts.fetch_add(1, std::memory_order_relaxed);
+
+    // Backpropagation, node i was reached by a move of toMove when i is odd
+    const boardState::status result = board.gameStatus();
+    for(int i=depth-1; i>=0; i--){
+        node &n = mNodes[path[i]];
+        const boardState::player mover = (i%2==1) ? toMove : opponentOf(toMove);
+        const boardState::status moverWins = (mover==boardState::X_PLAYER) ? boardState::X_WON : boardState::O_WON;
+
+        n.score.fetch_add((result==moverWins) ? WIN_POINTS : (result==boardState::DRAW) ? DRAW_POINTS : 0,
+                          std::memory_order_relaxed);
+        n.visits.fetch_add(1, std::memory_order_relaxed);
+        if(i>0){
+            n.virtualLoss.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+///
+/// \brief mctsEngine::runBatch Runs a few iterations, and queues the next batch while there is time
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param root Board at the root
+/// \param toMove Side to move at the root
+/// \param deadline End of the time budget
+/// \param seed Random generator seed
+///
+void mctsEngine::runBatch(const mnkBoard &root, const boardState::player toMove,
+                          const QDeadlineTimer &deadline, const quint64 seed)
+{
+    quint64 rng = seed | 1;
+
+    for(int i=0; i<ITERATIONS_PER_BATCH && !isStopped(deadline); i++){
+        mnkBoard board = root;
+        iterate(board, toMove, rng);
+    }
+
+    if(!isStopped(deadline) && mNodeCount.load(std::memory_order_relaxed)<mNodeCapacity){
+        const quint64 nextSeed = nextRandom(rng);
+        mPool->submit([this, root, toMove, deadline, nextSeed]{ runBatch(root, toMove, deadline, nextSeed); });
+    }
+}
+
+///
+/// \brief mctsEngine::bestMove Searches the best move until the time budget runs out
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board
+/// \param toMove Side to move
+/// \param cancelled If not null, checked between iterations to end the search early
+///
+/// \return Cell index, -1 if the game is over
+///
+int mctsEngine::bestMove(const mnkBoard &board, const boardState::player toMove,
+                         const std::atomic<bool> *cancelled)
+{
+    if(board.isOver()){
+        return -1;
+    }
+
+    mLastStats = searchStats();
+    mLastStats.threads = mPool->threadCount();
+
+    // No need to search when we win right now, or must block
+    int block = -1;
+    for(int i=0; i<board.cellCount(); i++){
+        if(board.isLegal(i)){
+            if(board.isWinningMove(i, toMove)){
+                return i;
+            }
+            if(block<0 && board.isWinningMove(i, opponentOf(toMove))){
+                block = i;
+            }
+        }
+    }
+    if(block>=0){
+        return block;
+    }
+
+    search(board, toMove, cancelled);
+
+    // The most visited move is the most reliable one
+    const node &root = mNodes[0];
+    int retVal = -1;
+    int bestVisits = -1;
+    for(int i=root.firstChild; i<root.firstChild + root.childCount; i++){
+        const int visits = mNodes[i].visits.load(std::memory_order_relaxed);
+        if(visits>bestVisits){
+            bestVisits = visits;
+            retVal = mNodes[i].move;
+        }
+    }
+
+    return retVal;
+}
+
+///
+/// \brief mctsEngine::rankMoves Searches a board and ranks its moves by visits
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board
+/// \param toMove Side to move
+/// \param moves Ranked moves, most visited first
+/// \param maxMoves Room in moves
+/// \param cancelled If not null, raising it ends the search early
+///
+/// \return Moves listed
+///
+int mctsEngine::rankMoves(const mnkBoard &board, const boardState::player toMove, int *moves, const int maxMoves,
+                          const std::atomic<bool> *cancelled)
+{
+    if(board.isOver() || maxMoves<=0){
+        return 0;
+    }
+
+    search(board, toMove, cancelled);
+
+    // Insertion into the short list, it holds a few moves only
+    int visits[MAX_RANKED_MOVES];
+    const int room = qMin(maxMoves, static_cast<int>(MAX_RANKED_MOVES));
+    int count = 0;
+    const node &root = mNodes[0];
+    for(int i=root.firstChild; i<root.firstChild + root.childCount; i++){
+        const int v = mNodes[i].visits.load(std::memory_order_relaxed);
+        int slot = count;
+        while(slot>0 && visits[slot - 1]<v){
+            slot--;
+        }
+        if(slot>=room){
+            continue;
+        }
+        for(int j=qMin(count, room - 1); j>slot; j--){
+            visits[j] = visits[j - 1];
+            moves[j] = moves[j - 1];
+        }
+        visits[slot] = v;
+        moves[slot] = mNodes[i].move;
+        count = qMin(count + 1, room);
+    }
+
+    return count;
+}
+
+///
+/// \brief mctsEngine::search Grows the tree of a board for the time budget
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board, not over
+/// \param toMove Side to move
+/// \param cancelled If not null, raising it ends the search early
+///
+void mctsEngine::search(const mnkBoard &board, const boardState::player toMove, const std::atomic<bool> *cancelled)
+{
+    QElapsedTimer timer;
+    timer.start();
+    const QDeadlineTimer deadline(mTimeBudget);
+
+    mLastStats = searchStats();
+    mLastStats.threads = mPool->threadCount();
+
+    if(!mNodes){
+        mNodes.reset(new node[mNodeCapacity]);
+    }
+
+    mNodeCount = 1;
+    mRollouts = 0;
+    mCancelled = cancelled;
+    initNode(0, -1);
+    expand(0, board);
+
+    const quint64 seed = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch())*0x9E3779B97F4A7C15ULL;
+    for(int i=0; i<mPool->threadCount()*BATCHES_PER_THREAD; i++){
+        const quint64 batchSeed = seed + i*0xBF58476D1CE4E5B9ULL;
+        mPool->submit([this, board, toMove, deadline, batchSeed]{ runBatch(board, toMove, deadline, batchSeed); });
+    }
+    mPool->wait();
+    mCancelled = nullptr;
+
+    mLastStats.rollouts = mRollouts.load();
+    mLastStats.nodes = qMin(mNodeCount.load(), mNodeCapacity);
+    mLastStats.elapsedNs = timer.nsecsElapsed();
+}
@@ -0,0 +1,94 @@
+#ifndef MCTSENGINE_H
+#define MCTSENGINE_H
+
+#include "mnkboard.h"
+#include "workstealingpool.h"
+
+#include <QDeadlineTimer>
+#include <QtGlobal>
+
+#include <atomic>
+#include <memory>
+
+///
+/// \brief The mctsEngine class
+///
+/// Tree-parallel Monte Carlo Tree Search for m,n,k boards. All the
+/// workers of a work-stealing pool grow the same tree: selection uses
+/// UCT with virtual loss, so concurrent workers spread over different
+/// branches, and nodes are expanded lock-free (one CAS per node). Nodes
+/// come from a pool allocated once, handed out with an atomic bump
+/// index. Rollouts are queued as small batches that requeue themselves
+/// until the per-move time budget runs out.
+///
+/// On big boards only the cells close to the marks already played are
+/// searched.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class mctsEngine
+{
+public:
+    static const int DEFAULT_NODE_CAPACITY = 1 << 20;
+    static const int DEFAULT_TIME_BUDGET   = 1000; // ms
+    static const int MAX_RANKED_MOVES      = 16;
+
+    struct searchStats {
+        quint64 rollouts = 0;
+        quint64 nodes    = 0;
+        qint64 elapsedNs = 0;
+        int threads      = 0;
+
+        double rolloutsPerSecond() const { return (elapsedNs==0) ? 0.00 : rollouts*1e9/elapsedNs; };
+    };
+
+    explicit mctsEngine(workStealingPool *pool, const int nodeCapacity = DEFAULT_NODE_CAPACITY);
+
+    void setTimeBudget(const int milliseconds) { mTimeBudget = qMax(1, milliseconds); };
+    int timeBudget() const { return mTimeBudget; };
+
+    // Setting cancelled ends the search early, with the best move found so far
+    int bestMove(const mnkBoard &board, const boardState::player toMove,
+                 const std::atomic<bool> *cancelled = nullptr);
+
+    // Searches for the time budget and lists up to maxMoves moves, most visited first
+    int rankMoves(const mnkBoard &board, const boardState::player toMove, int *moves, const int maxMoves,
+                  const std::atomic<bool> *cancelled = nullptr);
+    const searchStats &lastStats() const { return mLastStats; };
+
+protected:
+    enum nodeState {UNEXPANDED, EXPANDING, EXPANDED, LEAF};
+
+    struct node {
+        std::atomic<int> visits;
+        std::atomic<int> score;       // 2 per win and 1 per draw of the player moving here
+        std::atomic<int> virtualLoss;
+        std::atomic<int> state;
+        int firstChild;
+        int childCount;
+        int move;
+    };
+
+    workStealingPool *mPool;
+    std::unique_ptr<node[]> mNodes;
+    int mNodeCapacity;
+    std::atomic<int> mNodeCount;
+    std::atomic<quint64> mRollouts;
+    int mTimeBudget;
+    const std::atomic<bool> *mCancelled;
+    searchStats mLastStats;
+
+    void search(const mnkBoard &board, const boardState::player toMove, const std::atomic<bool> *cancelled);
+    void initNode(const int index, const int move);
+    bool expand(const int index, const mnkBoard &board);
+    int selectChild(const int index) const;
+    void runBatch(const mnkBoard &root, const boardState::player toMove,
+                  const QDeadlineTimer &deadline, const quint64 seed);
+    void iterate(mnkBoard &board, const boardState::player toMove, quint64 &rng);
+    bool isStopped(const QDeadlineTimer &deadline) const {
+        return deadline.hasExpired() || (mCancelled!=nullptr && mCancelled->load(std::memory_order_relaxed));
+    };
+};
+
+#endif // MCTSENGINE_H
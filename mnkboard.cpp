@@ -0,0 +1,222 @@
+#include "mnkboard.h"
+
+#include <algorithm>
+
+// Horizontal, vertical, main diagonal and anti diagonal
+const int TOTAL_DIRECTIONS = 4;
+const int DIRECTIONS[TOTAL_DIRECTIONS][2] = { {0, 1}, {1, 0}, {1, 1}, {1, -1} };
+
+///
+/// \brief mnkBoard::mnkBoard Main constructor, an empty board
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param rows Board rows, 1 to MAX_SIDE
+/// \param cols Board columns, 1 to MAX_SIDE
+/// \param winLength Marks in a row needed to win
+///
+mnkBoard::mnkBoard(const int rows, const int cols, const int winLength) :
+    mRows(std::max(1, std::min(rows, MAX_SIDE))),
+    mCols(std::max(1, std::min(cols, MAX_SIDE))),
+    mWinLength(std::max(1, winLength))
+{
+    clear();
+}
+
+///
+/// \brief mnkBoard::mnkBoard Classic 3 x 3 board with the marks of a compact board
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Compact board
+///
+mnkBoard::mnkBoard(const boardState &board) : mnkBoard(3, 3, 3)
+{
+    for(int i=0; i<boardState::TOTAL_CELLS && !isOver(); i++){
+        if(board.cell(i)!=EMPTY_CELL){
+            play(i, static_cast<boardState::player>(board.cell(i)));
+        }
+    }
+}
+
+///
+/// \brief mnkBoard::clear Empties the board
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void mnkBoard::clear()
+{
+    std::fill(mCells, mCells + MAX_CELLS, static_cast<int8_t>(EMPTY_CELL));
+    mMoveCount = 0;
+    mLastMove = -1;
+    mStatus = boardState::IN_PROGRESS;
+    mWinStart = -1;
+    mWinEnd = -1;
+}
+
+///
+/// \brief mnkBoard::countInDirection Counts the consecutive marks of a player
+/// starting next to a cell, up to winLength-1.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param row Start row
+/// \param col Start column
+/// \param dRow Row step
+/// \param dCol Column step
+/// \param p Player
+/// \param lastIndex Returns the index of the last counted cell, or of the start cell if none
+///
+/// \return Number of marks found
+///
+int mnkBoard::countInDirection(const int row, const int col, const int dRow, const int dCol,
+                               const boardState::player p, int *lastIndex) const
+{
+    int count = 0;
+    int r = row + dRow;
+    int c = col + dCol;
+    *lastIndex = row*mCols + col;
+
+    while(count<mWinLength-1 && r>=0 && r<mRows && c>=0 && c<mCols && mCells[r*mCols + c]==p){
+        *lastIndex = r*mCols + c;
+        count++;
+        r += dRow;
+        c += dCol;
+    }
+
+    return count;
+}
+
+///
+/// \brief mnkBoard::play Sets a mark and updates the status from that cell only,
+/// the move must be legal.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param index Cell index
+/// \param p Player
+///
+void mnkBoard::play(const int index, const boardState::player p)
+{
+    const int row = index/mCols;
+    const int col = index%mCols;
+
+    mCells[index] = static_cast<int8_t>(p);
+    mMoveCount++;
+    mLastMove = index;
+
+    for(int i=0; i<TOTAL_DIRECTIONS; i++){
+        int start = index;
+        int end = index;
+        const int count = 1 + countInDirection(row, col, -DIRECTIONS[i][0], -DIRECTIONS[i][1], p, &start) +
+                              countInDirection(row, col, DIRECTIONS[i][0], DIRECTIONS[i][1], p, &end);
+        if(count>=mWinLength){
+            mStatus = (p==boardState::X_PLAYER) ? boardState::X_WON : boardState::O_WON;
+            mWinStart = start;
+            mWinEnd = end;
+            return;
+        }
+    }
+
+    if(mMoveCount==cellCount()){
+        mStatus = boardState::DRAW;
+    }
+}
+
+///
+/// \brief mnkBoard::undo Takes back the last move, played in index
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param index Cell index
+///
+void mnkBoard::undo(const int index)
+{
+    mCells[index] = static_cast<int8_t>(EMPTY_CELL);
+    mMoveCount--;
+    mLastMove = -1;
+    mStatus = boardState::IN_PROGRESS;
+    mWinStart = -1;
+    mWinEnd = -1;
+}
+
+///
+/// \brief mnkBoard::isWinningMove Checks if a move would win the game, the board is not modified
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param index Cell index, must be empty
+/// \param p Player
+///
+/// \return true if playing index wins for p
+///
+bool mnkBoard::isWinningMove(const int index, const boardState::player p) const
+{
+    const int row = index/mCols;
+    const int col = index%mCols;
+    int last = index;
+
+    for(int i=0; i<TOTAL_DIRECTIONS; i++){
+        if(1 + countInDirection(row, col, -DIRECTIONS[i][0], -DIRECTIONS[i][1], p, &last) +
+               countInDirection(row, col, DIRECTIONS[i][0], DIRECTIONS[i][1], p, &last)>=mWinLength){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+///
+/// \brief mnkBoard::operator == Compares two boards
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param other Board to compare with
+///
+/// \return true if both have the same geometry and the same marks
+///
+bool mnkBoard::operator==(const mnkBoard &other) const
+{
+    if(mRows!=other.mRows || mCols!=other.mCols || mWinLength!=other.mWinLength ||
+       mMoveCount!=other.mMoveCount){
+        return false;
+    }
+
+    for(int i=0; i<cellCount(); i++){
+        if(mCells[i]!=other.mCells[i]){
+            return false;
+        }
+    }
+    return true;
+}
+
+///
+/// \brief mnkBoard::toBoardState Compact copy of a classic 3 x 3 board
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \return The bitboard, empty if this is not a classic board
+///
+boardState mnkBoard::toBoardState() const
+{
+    uint16_t masks[2] = {0, 0};
+
+    if(isClassic()){
+        for(int i=0; i<boardState::TOTAL_CELLS; i++){
+            if(mCells[i]!=EMPTY_CELL){
+                masks[mCells[i]] |= static_cast<uint16_t>(1u << i);
+            }
+        }
+    }
+
+    return boardState(masks[boardState::O_PLAYER], masks[boardState::X_PLAYER]);
+}
@@ -0,0 +1,77 @@
+#ifndef MNKBOARD_H
+#define MNKBOARD_H
+
+#include "boardstate.h"
+
+#include <cstdint>
+
+///
+/// \brief The mnkBoard class
+///
+/// Generalized m,n,k game: rows x cols board (up to 19 x 19), won with
+/// k marks in a row. Cells live in a flat, fixed-size array (row-major,
+/// index = row*cols + col) so copies never touch the heap. Wins are
+/// checked incrementally from the last move, walking at most k-1 cells
+/// each way on the 4 directions, so status cost does not grow with the
+/// board.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class mnkBoard
+{
+public:
+    static const int MAX_SIDE  = 19;
+    static const int MAX_CELLS = MAX_SIDE*MAX_SIDE;
+    static const int EMPTY_CELL = boardState::EMPTY_CELL;
+
+    mnkBoard(const int rows = 3, const int cols = 3, const int winLength = 3);
+    explicit mnkBoard(const boardState &board);
+
+    int rows() const { return mRows; };
+    int cols() const { return mCols; };
+    int winLength() const { return mWinLength; };
+    int cellCount() const { return mRows*mCols; };
+    int moveCount() const { return mMoveCount; };
+    int lastMove() const { return mLastMove; };
+    bool isClassic() const { return mRows==3 && mCols==3 && mWinLength==3; };
+
+    int cell(const int index) const { return mCells[index]; };
+    int cell(const int row, const int col) const { return mCells[row*mCols + col]; };
+    bool isLegal(const int index) const {
+        return mStatus==boardState::IN_PROGRESS && index>=0 && index<cellCount() && mCells[index]==EMPTY_CELL;
+    };
+
+    boardState::status gameStatus() const { return mStatus; };
+    bool isOver() const { return mStatus!=boardState::IN_PROGRESS; };
+
+    // Winning segment end cells, -1 if nobody has won
+    int winStart() const { return mWinStart; };
+    int winEnd() const { return mWinEnd; };
+
+    void play(const int index, const boardState::player p);
+    void undo(const int index);
+    void clear();
+
+    bool isWinningMove(const int index, const boardState::player p) const;
+    boardState toBoardState() const;
+
+    // Same geometry and marks
+    bool operator==(const mnkBoard &other) const;
+
+protected:
+    int mRows;
+    int mCols;
+    int mWinLength;
+    int mMoveCount;
+    int mLastMove;
+    boardState::status mStatus;
+    int mWinStart;
+    int mWinEnd;
+    int8_t mCells[MAX_CELLS];
+
+    int countInDirection(const int row, const int col, const int dRow, const int dCol,
+                         const boardState::player p, int *lastIndex) const;
+};
+
+#endif // MNKBOARD_H
@@ -0,0 +1,207 @@
+#include "movebatcher.h"
+#include "virtualplayer.h"
+
+#include <QDeadlineTimer>
+
+#include <algorithm>
+#include <chrono>
+
+const int LATENCY_SAMPLES = 65536;  // requests kept for the percentiles
+
+///
+/// \brief The moveBatcher::dispatcher class, runs the dispatch loop
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class moveBatcher::dispatcher : public QThread
+{
+public:
+    explicit dispatcher(moveBatcher *batcher) : mBatcher(batcher) {};
+
+protected:
+    moveBatcher *mBatcher;
+
+    void run() override { mBatcher->dispatchLoop(); };
+};
+
+///
+/// \brief moveBatcher::moveBatcher Main constructor, starts the dispatcher
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param player Virtual player making the moves
+/// \param maxBatch Most requests in a batch
+/// \param maxWaitMicroseconds Longest time a request waits for its batch to fill up
+///
+moveBatcher::moveBatcher(const virtualPlayer *player, const int maxBatch, const int maxWaitMicroseconds) :
+    mPlayer(player), mMaxBatch(qMax(1, maxBatch)), mMaxWaitNs(qMax(0, maxWaitMicroseconds)*qint64(1000)),
+    mStop(false), mNextLatency(0), mRequests(0), mBatches(0)
+{
+    mClock.start();
+    mLatencies.reserve(LATENCY_SAMPLES);
+
+    mDispatcher = new dispatcher(this);
+    mDispatcher->start();
+}
+
+///
+/// \brief moveBatcher::~moveBatcher Destructor, answers the pending requests and stops the dispatcher
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+moveBatcher::~moveBatcher()
+{
+    {
+        QMutexLocker ml(&mMutex);
+        mStop = true;
+        mWork.wakeAll();
+    }
+
+    mDispatcher->wait();
+    delete mDispatcher;
+}
+
+///
+/// \brief moveBatcher::submit Queues a move request
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Board, the virtual player moves next
+/// \param done Called with the move, on the dispatcher thread
+///
+void moveBatcher::submit(const boardState &board, std::function<void(int)> done)
+{
+    QMutexLocker ml(&mMutex);
+    mQueue.push_back(request{board, std::move(done), mClock.nsecsElapsed()});
+
+    // The dispatcher only cares about the first request and a full batch
+    const int queued = static_cast<int>(mQueue.size());
+    if(queued==1 || queued==mMaxBatch){
+        mWork.wakeOne();
+    }
+}
+
+///
+/// \brief moveBatcher::stats Throughput and latency so far
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \return The figures
+///
+moveBatcher::batchStats moveBatcher::stats() const
+{
+    batchStats s;
+    QVector<qint64> latencies;
+    {
+        QMutexLocker ml(&mStatsMutex);
+        s.requests = mRequests;
+        s.batches = mBatches;
+        latencies = mLatencies;
+    }
+
+    if(!latencies.isEmpty()){
+        const int p50 = latencies.size()/2;
+        const int p99 = qMin(latencies.size() - 1, latencies.size()*99/100);
+        std::nth_element(latencies.begin(), latencies.begin() + p50, latencies.end());
+        s.p50Ns = latencies[p50];
+        std::nth_element(latencies.begin(), latencies.begin() + p99, latencies.end());
+        s.p99Ns = latencies[p99];
+    }
+    return s;
+}
+
+///
+/// \brief moveBatcher::dispatchLoop Dispatcher thread main loop: waits for a batch to
+/// fill up or for its oldest request to run out of time, then runs it.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void moveBatcher::dispatchLoop()
+{
+    std::vector<request> batch;
+    std::vector<boardState> boards(mMaxBatch);
+    std::vector<double> scores(mMaxBatch*boardState::TOTAL_CELLS);
+    batch.reserve(mMaxBatch);
+
+    while(true){
+        {
+            QMutexLocker ml(&mMutex);
+            while(mQueue.empty() && !mStop){
+                mWork.wait(&mMutex);
+            }
+            if(mQueue.empty()){
+                return; // stopped, and nothing left to answer
+            }
+
+            while(static_cast<int>(mQueue.size())<mMaxBatch && !mStop){
+                const qint64 left = mQueue.front().submitted + mMaxWaitNs - mClock.nsecsElapsed();
+                if(left<=0){
+                    break;
+                }
+                mWork.wait(&mMutex, QDeadlineTimer(std::chrono::nanoseconds(left), Qt::PreciseTimer));
+            }
+
+            const int count = qMin(mMaxBatch, static_cast<int>(mQueue.size()));
+            for(int i=0; i<count; i++){
+                batch.push_back(std::move(mQueue.front()));
+                mQueue.pop_front();
+            }
+        }
+
+        runBatch(batch, boards, scores);
+        batch.clear();
+    }
+}
+
+///
+/// \brief moveBatcher::runBatch Moves a batch, one forward pass for all of it with the
+/// network engines, and answers its requests.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param batch Requests
+/// \param boards Scratch, at least maxBatch boards
+/// \param scores Scratch, at least maxBatch*TOTAL_CELLS scores
+///
+void moveBatcher::runBatch(std::vector<request> &batch, std::vector<boardState> &boards, std::vector<double> &scores)
+{
+    const int count = static_cast<int>(batch.size());
+    const bool network = virtualPlayer::isNetworkEngine(mPlayer->engine());
+
+    if(network){
+        for(int i=0; i<count; i++){
+            boards[i] = batch[i].board;
+        }
+        mPlayer->scoreMoves(boards.data(), count, scores.data());
+    }
+
+    for(int i=0; i<count; i++){
+        const int move = network ? virtualPlayer::pickMove(scores.data() + i*boardState::TOTAL_CELLS, mPlayer->topK())
+                                 : mPlayer->chooseMove(batch[i].board);
+        batch[i].done(move);
+    }
+
+    // The callbacks are short, the whole batch is answered at once
+    const qint64 answered = mClock.nsecsElapsed();
+
+    QMutexLocker ml(&mStatsMutex);
+    for(int i=0; i<count; i++){
+        const qint64 latency = answered - batch[i].submitted;
+        if(mLatencies.size()<LATENCY_SAMPLES){
+            mLatencies.append(latency);
+        }
+        else{
+            mLatencies[mNextLatency] = latency;
+            mNextLatency = (mNextLatency + 1) % LATENCY_SAMPLES;
+        }
+    }
+    mRequests += count;
+    mBatches++;
+}
@@ -0,0 +1,95 @@
+#ifndef MOVEBATCHER_H
+#define MOVEBATCHER_H
+
+#include "boardstate.h"
+
+#include <QVector>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+class virtualPlayer;
+
+///
+/// \brief The moveBatcher class
+///
+/// Gathers the move requests of many games into micro-batches, so the
+/// network runs one batched forward pass for all of them instead of one
+/// small pass per game. A batch leaves when it holds maxBatch requests,
+/// or when its oldest request has waited maxWait microseconds, whichever
+/// comes first. Bigger batches and longer waits buy throughput with
+/// latency; stats() reports both to tune them under real load.
+///
+/// One dispatcher thread builds and runs the batches and calls back the
+/// callers from there, callbacks must be short (post the move elsewhere).
+/// It is meant for the network engines (virtualPlayer::isNetworkEngine):
+/// any other engine would be moved one by one on the dispatcher thread,
+/// callers should send those moves to a pool instead. With the network
+/// cache on, the hits of a batch are answered from the cache and only the
+/// misses go through the forward pass. submit() is thread safe.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class moveBatcher
+{
+public:
+    struct batchStats {
+        quint64 requests = 0;
+        quint64 batches  = 0;
+        qint64 p50Ns     = 0;   // submit to callback, over the last requests
+        qint64 p99Ns     = 0;
+
+        double meanBatch() const { return (batches==0) ? 0.00 : static_cast<double>(requests)/batches; };
+    };
+
+    moveBatcher(const virtualPlayer *player, const int maxBatch, const int maxWaitMicroseconds);
+    ~moveBatcher();
+
+    int maxBatch() const { return mMaxBatch; };
+    int maxWait() const { return static_cast<int>(mMaxWaitNs/1000); };
+
+    // done(move) is called on the dispatcher thread
+    void submit(const boardState &board, std::function<void(int)> done);
+
+    batchStats stats() const;
+
+protected:
+    class dispatcher;
+
+    struct request {
+        boardState board;
+        std::function<void(int)> done;
+        qint64 submitted;  // ns on mClock
+    };
+
+    const virtualPlayer *mPlayer;
+    const int mMaxBatch;
+    const qint64 mMaxWaitNs;
+    QElapsedTimer mClock;
+
+    std::deque<request> mQueue;
+    bool mStop;
+    QMutex mMutex;
+    QWaitCondition mWork;
+
+    // Latency ring of the last requests, and totals
+    QVector<qint64> mLatencies;
+    int mNextLatency;
+    quint64 mRequests;
+    quint64 mBatches;
+    mutable QMutex mStatsMutex;
+
+    // Last, it must stop before anything else goes
+    dispatcher *mDispatcher;
+
+    void dispatchLoop();
+    void runBatch(std::vector<request> &batch, std::vector<boardState> &boards, std::vector<double> &scores);
+};
+
+#endif // MOVEBATCHER_H
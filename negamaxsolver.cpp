@@ -0,0 +1,164 @@
+#include "negamaxsolver.h"
+
+#include <QElapsedTimer>
+
+const int TABLE_SIZE    = 1 << (2*boardState::TOTAL_CELLS); // direct mapped, one slot per key
+const int WIN_SCORE     = 10;  // faster wins score higher, slower losses too
+const int INFINITE      = 100;
+const int NO_MOVE       = 0xFF;
+const int MOVE_ORDER[boardState::TOTAL_CELLS] = {4, 0, 2, 6, 8, 1, 3, 5, 7};
+
+///
+/// \brief negamaxSolver::negamaxSolver Default constructor
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+negamaxSolver::negamaxSolver() : mLastScore(0)
+{
+    clearTable();
+}
+
+///
+/// \brief negamaxSolver::clearTable Forgets every searched position
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void negamaxSolver::clearTable()
+{
+    const ttEntry empty = {0, NO_BOUND, NO_MOVE};
+    mTable.fill(empty, TABLE_SIZE);
+}
+
+///
+/// \brief negamaxSolver::bestMove Searches the best move for the side to move
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board
+/// \param toMove Side to move
+///
+/// \return Cell index, -1 if the game is over
+///
+int negamaxSolver::bestMove(const boardState &board, const boardState::player toMove)
+{
+    if(board.isOver()){
+        return -1;
+    }
+
+    const boardState::player opponent = (toMove==boardState::X_PLAYER) ? boardState::O_PLAYER : boardState::X_PLAYER;
+    QElapsedTimer timer;
+    timer.start();
+
+    mLastStats = searchStats();
+    mLastStats.searches = 1;
+
+    int retVal = -1;
+    mLastScore = search(board.mask(toMove), board.mask(opponent), -INFINITE, INFINITE, &retVal);
+    mLastStats.elapsedNs = timer.nsecsElapsed();
+
+    mTotalStats.nodes += mLastStats.nodes;
+    mTotalStats.ttProbes += mLastStats.ttProbes;
+    mTotalStats.ttHits += mLastStats.ttHits;
+    mTotalStats.elapsedNs += mLastStats.elapsedNs;
+    mTotalStats.searches++;
+
+    return retVal;
+}
+
+///
+/// \brief negamaxSolver::search Negamax with alpha-beta pruning
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param mover Marks of the side to move
+/// \param opponent Marks of the other side
+/// \param alpha Lower bound
+/// \param beta Upper bound
+/// \param bestMove If not null, the search does not stop on a table hit
+/// and the best move is returned here.
+///
+/// \return Score from the mover point of view, > 0 win, 0 draw, < 0 loss
+///
+int negamaxSolver::search(const quint16 mover, const quint16 opponent, int alpha, int beta, int *bestMove)
+{
+    mLastStats.nodes++;
+
+    // Canonical key, O = mover
+    quint32 key = mover | (static_cast<quint32>(opponent) << boardState::TOTAL_CELLS);
+    int symmetry = 0;
+    for(int s=1; s<boardState::TOTAL_SYMMETRIES; s++){
+        const quint32 k = SYMMETRY_MASKS.masks[s][mover] |
+                          (static_cast<quint32>(SYMMETRY_MASKS.masks[s][opponent]) << boardState::TOTAL_CELLS);
+        if(k<key){
+            key = k;
+            symmetry = s;
+        }
+    }
+
+    // Transposition table probe
+    ttEntry &entry = mTable[key];
+    int ttMove = NO_MOVE;
+    mLastStats.ttProbes++;
+    if(entry.bound!=NO_BOUND){
+        mLastStats.ttHits++;
+        ttMove = boardState::SYMMETRIES[boardState::INVERSE_SYMMETRY[symmetry]][entry.move];
+
+        if(bestMove==nullptr){
+            if(entry.bound==EXACT){
+                return entry.score;
+            }
+            if(entry.bound==LOWER_BOUND){
+                alpha = qMax(alpha, static_cast<int>(entry.score));
+            }
+            else{
+                beta = qMin(beta, static_cast<int>(entry.score));
+            }
+            if(alpha>=beta){
+                return entry.score;
+            }
+        }
+    }
+
+    const int originalAlpha = alpha;
+    const quint16 occupied = mover | opponent;
+    const int moves = boardState::popCount(occupied);
+    int bestScore = -INFINITE;
+    int best = NO_MOVE;
+
+    for(int i=-1; i<boardState::TOTAL_CELLS && alpha<beta; i++){
+        // Table move first, then the static order
+        const int move = (i<0) ? ttMove : MOVE_ORDER[i];
+        if(move==NO_MOVE || (i>=0 && move==ttMove) || (occupied & (1u << move))){
+            continue;
+        }
+
+        const quint16 next = mover | static_cast<quint16>(1u << move);
+        int score = 0;
+        if(boardState::hasWinLine(next)){
+            score = WIN_SCORE - moves;
+        }
+        else if((next | opponent)!=boardState::FULL_BOARD){
+            score = -search(opponent, next, -beta, -alpha, nullptr);
+        }
+
+        if(score>bestScore){
+            bestScore = score;
+            best = move;
+        }
+        alpha = qMax(alpha, score);
+    }
+
+    entry.score = static_cast<qint8>(bestScore);
+    entry.bound = (bestScore<=originalAlpha) ? UPPER_BOUND : (bestScore>=beta) ? LOWER_BOUND : EXACT;
+    entry.move = boardState::SYMMETRIES[symmetry][best];
+
+    if(bestMove!=nullptr){
+        *bestMove = best;
+    }
+
+    return bestScore;
+}
@@ -0,0 +1,63 @@
+#ifndef NEGAMAXSOLVER_H
+#define NEGAMAXSOLVER_H
+
+#include "boardstate.h"
+
+#include <QVector>
+#include <QtGlobal>
+
+///
+/// \brief The negamaxSolver class
+///
+/// Exact search engine: negamax with alpha-beta pruning and move
+/// ordering (transposition table move first, then center, corners and
+/// edges). The transposition table is keyed by the board canonicalized
+/// under the 8 symmetries of the square, so every rotated or reflected
+/// copy of a position is searched only once. It is kept between moves.
+///
+/// Not thread safe, use one solver per thread.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class negamaxSolver
+{
+public:
+    // Cost of the last search, and of all of them
+    struct searchStats {
+        quint64 nodes    = 0;
+        quint64 ttProbes = 0;
+        quint64 ttHits   = 0;
+        qint64 elapsedNs = 0;
+        quint64 searches = 0;
+
+        double ttHitRate() const { return (ttProbes==0) ? 0.00 : static_cast<double>(ttHits)/ttProbes; };
+    };
+
+    negamaxSolver();
+
+    int bestMove(const boardState &board, const boardState::player toMove);
+    int lastScore() const { return mLastScore; };
+    const searchStats &lastStats() const { return mLastStats; };
+    const searchStats &totalStats() const { return mTotalStats; };
+
+    void clearTable();
+
+protected:
+    enum boundType {NO_BOUND, EXACT, LOWER_BOUND, UPPER_BOUND};
+
+    struct ttEntry {
+        qint8 score;
+        quint8 bound;
+        quint8 move;  // in the canonical frame
+    };
+
+    QVector<ttEntry> mTable;
+    searchStats mLastStats;
+    searchStats mTotalStats;
+    int mLastScore;
+
+    int search(const quint16 mover, const quint16 opponent, int alpha, int beta, int *bestMove);
+};
+
+#endif // NEGAMAXSOLVER_H
@@ -0,0 +1,271 @@
+#include "networkmodel.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QDebug>
+
+#include <cstring>
+
+///
+/// \brief networkModel::networkModel Default constructor, empty model
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+networkModel::networkModel()
+{
+}
+
+///
+/// \brief networkModel::networkModel Builds a model from layers already in memory
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param layers Network layers, input layer first
+///
+networkModel::networkModel(const QVector<layerMatrix> &layers) : mLayers(layers)
+{
+}
+
+///
+/// \brief networkModel::fail Records a load error
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param error Error description
+///
+/// \return Always false
+///
+bool networkModel::fail(const QString &error)
+{
+    mError = error;
+    qWarning() << "networkModel:" << error;
+    return false;
+}
+
+///
+/// \brief networkModel::loadCsv Parses one theta CSV file per layer
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param layerFiles Theta files, input layer first. One line per neuron, bias weight first.
+///
+/// \return true on success, the model is left untouched otherwise
+///
+bool networkModel::loadCsv(const QStringList &layerFiles)
+{
+    QVector<layerMatrix> layers;
+
+    for(const QString &fileName : layerFiles){
+        QFile file(fileName);
+        if(!file.open(QIODevice::ReadOnly | QIODevice::Text)){
+            return fail(QStringLiteral("cannot open %1: %2").arg(fileName, file.errorString()));
+        }
+
+        QVector<QVector<double>> theta;
+        QTextStream stream(&file);
+        for(int line=1; !stream.atEnd(); line++){
+            const QString text = stream.readLine().trimmed();
+            if(text.isEmpty()){
+                continue;
+            }
+
+            const QStringList fields = text.split(QLatin1Char(','));
+            QVector<double> neuron(fields.size(), 0.00);
+            for(int i=0; i<fields.size(); i++){
+                bool ok = false;
+                neuron[i] = fields[i].trimmed().toDouble(&ok);
+                if(!ok){
+                    return fail(QStringLiteral("%1:%2: bad value \"%3\"").arg(fileName).arg(line).arg(fields[i]));
+                }
+            }
+            if(!theta.isEmpty() && neuron.size()!=theta.first().size()){
+                return fail(QStringLiteral("%1:%2: expected %3 values").arg(fileName).arg(line).arg(theta.first().size()));
+            }
+            theta.append(neuron);
+        }
+
+        if(theta.isEmpty()){
+            return fail(QStringLiteral("%1: no neurons").arg(fileName));
+        }
+        layers.append(layerMatrix(theta));
+    }
+
+    mLayers = layers;
+    mFile.clear();
+    mError.clear();
+    return true;
+}
+
+///
+/// \brief networkModel::loadBinary Maps a binary model file. The layers point straight
+/// into the mapping, nothing is parsed nor copied.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param fileName Binary model file
+///
+/// \return true on success, the model is left untouched otherwise
+///
+bool networkModel::loadBinary(const QString &fileName)
+{
+    QSharedPointer<QFile> file(new QFile(fileName));
+    if(!file->open(QIODevice::ReadOnly)){
+        return fail(QStringLiteral("cannot open %1: %2").arg(fileName, file->errorString()));
+    }
+
+    const qint64 size = file->size();
+    if(size<static_cast<qint64>(sizeof(fileHeader))){
+        return fail(QStringLiteral("%1: truncated header").arg(fileName));
+    }
+
+    const uchar *data = file->map(0, size);
+    if(data==nullptr){
+        return fail(QStringLiteral("cannot map %1: %2").arg(fileName, file->errorString()));
+    }
+
+    fileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if(header.magic!=MAGIC || header.version!=VERSION){
+        return fail(QStringLiteral("%1: not a version %2 model file").arg(fileName).arg(VERSION));
+    }
+
+    const qint64 tableEnd = sizeof(fileHeader) + static_cast<qint64>(header.layerCount)*sizeof(layerHeader);
+    if(header.layerCount==0 || tableEnd>size){
+        return fail(QStringLiteral("%1: bad layer table").arg(fileName));
+    }
+
+    QVector<layerMatrix> layers;
+    for(uint32_t i=0; i<header.layerCount; i++){
+        layerHeader layer;
+        std::memcpy(&layer, data + sizeof(fileHeader) + i*sizeof(layerHeader), sizeof(layer));
+
+        const qint64 bytes = static_cast<qint64>(layer.inputs)*layer.stride*sizeof(double);
+        if(layer.inputs==0 || layer.outputs==0 ||
+           static_cast<int>(layer.stride)!=layerMatrix::paddedSize(static_cast<int>(layer.outputs)) ||
+           layer.offset%DATA_ALIGNMENT!=0 || layer.offset<tableEnd || layer.offset + bytes>size){
+            return fail(QStringLiteral("%1: bad layer %2").arg(fileName).arg(i));
+        }
+
+        layers.append(layerMatrix::view(reinterpret_cast<const double*>(data + layer.offset),
+                                        static_cast<int>(layer.inputs), static_cast<int>(layer.outputs)));
+    }
+
+    // The file stays open, some platforms drop the mapping on close
+    mLayers = layers;
+    mFile = file;
+    mError.clear();
+    return true;
+}
+
+///
+/// \brief networkModel::saveBinary Writes the model in the binary format
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param fileName Output file, replaced only when the whole model is written
+///
+/// \return true on success
+///
+bool networkModel::saveBinary(const QString &fileName) const
+{
+    fileHeader header = {MAGIC, VERSION, static_cast<uint32_t>(mLayers.size()), 0};
+    QVector<layerHeader> table(mLayers.size());
+
+    int offset = alignedOffset(sizeof(fileHeader) + mLayers.size()*sizeof(layerHeader));
+    for(int i=0; i<mLayers.size(); i++){
+        table[i].inputs = static_cast<uint32_t>(mLayers[i].inputs());
+        table[i].outputs = static_cast<uint32_t>(mLayers[i].outputs());
+        table[i].stride = static_cast<uint32_t>(mLayers[i].stride());
+        table[i].offset = static_cast<uint32_t>(offset);
+        offset = alignedOffset(offset + mLayers[i].inputs()*mLayers[i].stride()*sizeof(double));
+    }
+
+    QByteArray image(offset, '\0');
+    std::memcpy(image.data(), &header, sizeof(header));
+    std::memcpy(image.data() + sizeof(header), table.constData(), table.size()*sizeof(layerHeader));
+    for(int i=0; i<mLayers.size(); i++){
+        std::memcpy(image.data() + table[i].offset, mLayers[i].values(),
+                    mLayers[i].inputs()*mLayers[i].stride()*sizeof(double));
+    }
+
+    QSaveFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly) || file.write(image)!=image.size() || !file.commit()){
+        qWarning() << "networkModel: cannot write" << fileName << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+///
+/// \brief networkModel::saveCsv Writes one theta CSV file per layer, the format loadCsv reads
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param layerFiles Output files, input layer first, one per layer
+///
+/// \return true on success
+///
+bool networkModel::saveCsv(const QStringList &layerFiles) const
+{
+    if(layerFiles.size()!=mLayers.size()){
+        qWarning() << "networkModel:" << mLayers.size() << "layers," << layerFiles.size() << "files";
+        return false;
+    }
+
+    for(int l=0; l<mLayers.size(); l++){
+        QSaveFile file(layerFiles[l]);
+        if(!file.open(QIODevice::WriteOnly | QIODevice::Text)){
+            qWarning() << "networkModel: cannot write" << layerFiles[l] << file.errorString();
+            return false;
+        }
+
+        QTextStream stream(&file);
+        for(int n=0; n<mLayers[l].outputs(); n++){
+            for(int k=0; k<mLayers[l].inputs(); k++){
+                stream << (k>0 ? "," : "") << QString::number(mLayers[l].row(k)[n], 'g', 16);
+            }
+            stream << "\n";
+        }
+
+        stream.flush();
+        if(!file.commit()){
+            qWarning() << "networkModel: cannot write" << layerFiles[l] << file.errorString();
+            return false;
+        }
+    }
+    return true;
+}
+
+///
+/// \brief networkModel::fits Checks the model is a chain of layers from inputs to outputs,
+/// each layer taking a bias plus the outputs of the previous one.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param inputs Inputs of the first layer, bias included
+/// \param outputs Outputs of the last layer
+///
+/// \return true if the model can be evaluated
+///
+bool networkModel::fits(const int inputs, const int outputs) const
+{
+    if(mLayers.isEmpty() || mLayers.first().inputs()!=inputs || mLayers.last().outputs()!=outputs){
+        return false;
+    }
+
+    for(int i=1; i<mLayers.size(); i++){
+        if(mLayers[i].inputs()!=mLayers[i-1].outputs() + 1){
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,79 @@
+#ifndef NETWORKMODEL_H
+#define NETWORKMODEL_H
+
+#include "layermatrix.h"
+
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QSharedPointer>
+
+#include <cstdint>
+
+class QFile;
+
+///
+/// \brief The networkModel class
+///
+/// Weights of the move network, one layerMatrix per layer, any number
+/// of layers of any size. Models come from the theta CSV files (one
+/// file per layer, one line per neuron, bias weight first) or from the
+/// binary model format, which is mapped in memory and used in place.
+///
+/// Binary format, host byte order (a foreign file fails the magic
+/// check), every block 32-byte aligned:
+///
+///     fileHeader                       magic, version, layer count
+///     layerHeader x layerCount         inputs, outputs, stride, offset
+///     double[inputs*stride] per layer  layerMatrix layout, transposed and padded
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class networkModel
+{
+public:
+    static const uint32_t MAGIC   = 0x4C444D54; // "TMDL"
+    static const uint32_t VERSION = 1;
+    static const int DATA_ALIGNMENT = 32;
+
+    struct fileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t layerCount;
+        uint32_t reserved;
+    };
+
+    struct layerHeader {
+        uint32_t inputs;
+        uint32_t outputs;
+        uint32_t stride;
+        uint32_t offset;  // from the start of the file, in bytes
+    };
+
+    networkModel();
+    explicit networkModel(const QVector<layerMatrix> &layers);
+
+    bool loadCsv(const QStringList &layerFiles);
+    bool loadBinary(const QString &fileName);
+    bool saveBinary(const QString &fileName) const;
+    bool saveCsv(const QStringList &layerFiles) const;
+
+    bool isEmpty() const { return mLayers.isEmpty(); };
+    bool isMapped() const { return !mFile.isNull(); };
+    const QVector<layerMatrix> &layers() const { return mLayers; };
+    QString errorString() const { return mError; };
+
+    // Fully connected chain with a bias input in front of every layer
+    bool fits(const int inputs, const int outputs) const;
+
+protected:
+    QVector<layerMatrix> mLayers;
+    QSharedPointer<QFile> mFile; // keeps the mapping alive for the layer views
+    QString mError;
+
+    bool fail(const QString &error);
+    static int alignedOffset(const int offset) { return ((offset + DATA_ALIGNMENT - 1)/DATA_ALIGNMENT)*DATA_ALIGNMENT; };
+};
+
+#endif // NETWORKMODEL_H
@@ -0,0 +1,327 @@
+#include "perfectplay.h"
+
+#include <array>
+
+///
+/// \brief makeBase3Digits Base 3 value of every 9-bit mask, so a table index
+/// costs two loads and an add.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+static constexpr std::array<uint16_t, boardState::FULL_BOARD + 1> makeBase3Digits()
+{
+    std::array<uint16_t, boardState::FULL_BOARD + 1> retVal = {};
+    for(int mask=0; mask<=boardState::FULL_BOARD; mask++){
+        retVal[mask] = static_cast<uint16_t>(perfectPlay::base3(static_cast<uint16_t>(mask)));
+    }
+    return retVal;
+}
+
+static constexpr std::array<uint16_t, boardState::FULL_BOARD + 1> BASE3_DIGITS = makeBase3Digits();
+
+///
+/// \brief makeWinningMasks Tells for every 9-bit mask if it holds a win line, so the
+/// solver below tests a move with one load.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+static constexpr std::array<bool, boardState::FULL_BOARD + 1> makeWinningMasks()
+{
+    std::array<bool, boardState::FULL_BOARD + 1> retVal = {};
+    for(int mask=0; mask<=boardState::FULL_BOARD; mask++){
+        retVal[mask] = boardState::hasWinLine(static_cast<uint16_t>(mask));
+    }
+    return retVal;
+}
+
+static constexpr std::array<bool, boardState::FULL_BOARD + 1> WINNING_MASKS = makeWinningMasks();
+
+///
+/// \brief The perfectPlayTable struct The table, solved by the compiler. Negamax over
+/// (mover, opponent) masks from the empty board, memoized in the table, reaches every
+/// position that can be played. Other entries are left at 0xFF, no move and no value.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+struct perfectPlayTable {
+    static constexpr int8_t NO_SCORE  = -100;
+    static constexpr int8_t WIN_SCORE = 10;  // faster wins score higher, slower losses too
+
+    uint8_t entries[perfectPlay::TABLE_SIZE];
+    int8_t scores[perfectPlay::TABLE_SIZE];
+
+    constexpr perfectPlayTable() : entries(), scores() {
+        for(int i=0; i<perfectPlay::TABLE_SIZE; i++){
+            entries[i] = 0xFF;
+            scores[i] = NO_SCORE;
+        }
+        solve(0, 0);
+    };
+
+    // Score from the mover point of view, > 0 win, 0 draw, < 0 loss
+    constexpr int solve(const uint16_t mover, const uint16_t opponent) {
+        const int index = BASE3_DIGITS[mover] + 2*BASE3_DIGITS[opponent];
+        if(scores[index]!=NO_SCORE){
+            return scores[index];
+        }
+
+        const uint16_t empty = boardState::FULL_BOARD & ~(mover | opponent);
+        const int moves = boardState::popCount(mover | opponent);
+        int bestScore = NO_SCORE;
+        int bestMove = perfectPlay::NO_MOVE;
+
+        for(int i=0; i<boardState::TOTAL_CELLS; i++){
+            if(empty & (1u << i)){
+                const uint16_t played = static_cast<uint16_t>(mover | (1u << i));
+
+                int score = 0;
+                if(WINNING_MASKS[played]){
+                    score = WIN_SCORE - moves;
+                }
+                else if((played | opponent)!=boardState::FULL_BOARD){
+                    score = -solve(opponent, played);
+                }
+
+                if(score>bestScore){
+                    bestScore = score;
+                    bestMove = i;
+                }
+            }
+        }
+
+        const perfectPlay::gameValue value = bestScore>0 ? perfectPlay::WIN :
+                                             bestScore<0 ? perfectPlay::LOSS : perfectPlay::DRAW;
+        scores[index] = static_cast<int8_t>(bestScore);
+        entries[index] = perfectPlay::entry(bestMove, value);
+
+        return bestScore;
+    };
+};
+
+static constexpr perfectPlayTable TABLE;
+
+///
+/// \brief perfectPlay::lookupIndex Table index of a board, from the side to move point of view
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board
+/// \param toMove Side to move
+///
+/// \return Table index
+///
+int perfectPlay::lookupIndex(const boardState &board, const boardState::player toMove)
+{
+    const boardState::player opponent = (toMove==boardState::X_PLAYER) ? boardState::O_PLAYER : boardState::X_PLAYER;
+    return BASE3_DIGITS[board.mask(toMove)] + 2*BASE3_DIGITS[board.mask(opponent)];
+}
+
+///
+/// \brief perfectPlay::bestMove Returns the best move for the side to move
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board
+/// \param toMove Side to move
+///
+/// \return Cell index, -1 if the game is over or the position is not legal
+///
+int perfectPlay::bestMove(const boardState &board, const boardState::player toMove)
+{
+    const int move = entryMove(TABLE.entries[lookupIndex(board, toMove)]);
+    return (move==NO_MOVE) ? -1 : move;
+}
+
+///
+/// \brief perfectPlay::positionValue Returns the game-theoretic value of a position
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board
+/// \param toMove Side to move
+///
+/// \return Value for the side to move, NO_VALUE if the game is over or the position is not legal
+///
+perfectPlay::gameValue perfectPlay::positionValue(const boardState &board, const boardState::player toMove)
+{
+    const uint8_t value = entryValue(TABLE.entries[lookupIndex(board, toMove)]);
+    return (value>NO_VALUE) ? NO_VALUE : static_cast<gameValue>(value);
+}
+
+///
+/// \brief perfectPlay::moveValue Returns the game-theoretic value of playing a move
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board
+/// \param toMove Side to move
+/// \param move Cell to play
+///
+/// \return Value for the side to move after the move, NO_VALUE if the move is not legal
+///
+perfectPlay::gameValue perfectPlay::moveValue(const boardState &board, const boardState::player toMove, const int move)
+{
+    if(!board.isLegal(move)){
+        return NO_VALUE;
+    }
+
+    boardState child = board;
+    child.play(move, toMove);
+
+    switch(child.gameStatus()){
+        case boardState::O_WON:
+        case boardState::X_WON:
+            return WIN;
+        case boardState::DRAW:
+            return DRAW;
+        case boardState::IN_PROGRESS:
+            break;
+    };
+
+    // The opponent's value is ours, upside down
+    const boardState::player opponent = (toMove==boardState::X_PLAYER) ? boardState::O_PLAYER : boardState::X_PLAYER;
+    const gameValue opponentValue = positionValue(child, opponent);
+    return (opponentValue==NO_VALUE) ? NO_VALUE : static_cast<gameValue>(WIN - opponentValue);
+}
+
+///
+/// \brief perfectPlay::visitPositions Visits once every position an engine can face,
+/// no matter who starts the game.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param visit Called for every position with engineSide to move
+/// \param engineSide Marks played by the engine
+///
+void perfectPlay::visitPositions(const std::function<void(const boardState &)> &visit,
+                                 const boardState::player engineSide)
+{
+    std::array<bool, TABLE_SIZE> visited = {};
+
+    // Walk every game, the engine is asked on its own turns only
+    std::function<void(boardState &, const boardState::player)> walk = [&](boardState &board, const boardState::player toMove){
+        if(board.isOver()){
+            return;
+        }
+
+        const boardState::player opponent = (toMove==boardState::X_PLAYER) ? boardState::O_PLAYER : boardState::X_PLAYER;
+
+        if(toMove==engineSide){
+            const int index = lookupIndex(board, toMove);
+            if(visited[index]){
+                return;
+            }
+            visited[index] = true;
+            visit(board);
+        }
+
+        for(int i=0; i<boardState::TOTAL_CELLS; i++){
+            if(board.isLegal(i)){
+                board.play(i, toMove);
+                walk(board, opponent);
+                board.undo(i);
+            }
+        }
+    };
+
+    boardState board;
+    walk(board, boardState::X_PLAYER);
+    walk(board, boardState::O_PLAYER);
+}
+
+///
+/// \brief perfectPlay::measureEngine Compares the moves of an engine with perfect play, in every
+/// position the engine can face, no matter who starts the game.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param chooseMove Engine under test, returns its move for a board
+/// \param engineSide Marks played by the engine
+///
+/// \return The accuracy report
+///
+perfectPlay::accuracyReport perfectPlay::measureEngine(const std::function<int(const boardState &)> &chooseMove,
+                                                       const boardState::player engineSide)
+{
+    accuracyReport retVal;
+
+    visitPositions([&](const boardState &board){
+        retVal.positions++;
+
+        const gameValue best = positionValue(board, engineSide);
+        const gameValue played = moveValue(board, engineSide, chooseMove(board));
+
+        if(played==NO_VALUE){
+            retVal.illegalMoves++;
+        }
+        else if(played==best){
+            retVal.optimalMoves++;
+        }
+        else if(best==WIN){
+            (played==DRAW) ? retVal.winToDraw++ : retVal.winToLoss++;
+        }
+        else{
+            retVal.drawToLoss++;
+        }
+    }, engineSide);
+
+    return retVal;
+}
+
+///
+/// \brief perfectPlay::measureAgreement Compares the moves of two engines in every position
+/// they can face, and the game value of the moves they disagree on.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param reference Reference engine, returns its move for a board
+/// \param candidate Engine under test
+/// \param engineSide Marks played by the engines
+///
+/// \return The agreement report
+///
+perfectPlay::agreementReport perfectPlay::measureAgreement(const std::function<int(const boardState &)> &reference,
+                                                           const std::function<int(const boardState &)> &candidate,
+                                                           const boardState::player engineSide)
+{
+    agreementReport retVal;
+
+    visitPositions([&](const boardState &board){
+        retVal.positions++;
+
+        const int referenceMove = reference(board);
+        const int candidateMove = candidate(board);
+        if(referenceMove==candidateMove){
+            retVal.sameMoves++;
+            return;
+        }
+
+        // NO_VALUE (an illegal move) is the worst of all
+        const int referenceValue = moveValue(board, engineSide, referenceMove);
+        const int candidateValue = moveValue(board, engineSide, candidateMove);
+        const int referenceRank = (referenceValue==NO_VALUE) ? -1 : referenceValue;
+        const int candidateRank = (candidateValue==NO_VALUE) ? -1 : candidateValue;
+
+        if(candidateRank==referenceRank){
+            retVal.sameValue++;
+        }
+        else if(candidateRank>referenceRank){
+            retVal.betterValue++;
+        }
+        else{
+            retVal.worseValue++;
+        }
+    }, engineSide);
+
+    return retVal;
+}
@@ -0,0 +1,82 @@
+#ifndef PERFECTPLAY_H
+#define PERFECTPLAY_H
+
+#include "boardstate.h"
+
+#include <cstdint>
+#include <functional>
+
+///
+/// \brief The perfectPlay class
+///
+/// Game-theoretic value and best move of every 3 x 3 position, looked
+/// up in a table the compiler solves (constexpr, see perfectplay.cpp). The
+/// table is indexed from the side to move point of view, so the same
+/// entry serves both players: index = base3(mover) + 2*base3(opponent).
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class perfectPlay
+{
+public:
+    enum gameValue {LOSS, DRAW, WIN, NO_VALUE};
+
+    // Engine accuracy against perfect play
+    struct accuracyReport {
+        int positions    = 0;
+        int optimalMoves = 0;
+        int winToDraw    = 0;
+        int winToLoss    = 0;
+        int drawToLoss   = 0;
+        int illegalMoves = 0;
+    };
+
+    // Agreement of two engines, on the same positions
+    struct agreementReport {
+        int positions   = 0;
+        int sameMoves   = 0;
+        int sameValue   = 0;  // different move, same game value
+        int betterValue = 0;  // the candidate move is worth more than the reference one
+        int worseValue  = 0;
+    };
+
+    static const int TABLE_SIZE = 19683; // 3^9
+    static const uint8_t NO_MOVE = 0x0F;
+
+    static int bestMove(const boardState &board, const boardState::player toMove);
+    static gameValue positionValue(const boardState &board, const boardState::player toMove);
+    static gameValue moveValue(const boardState &board, const boardState::player toMove, const int move);
+
+    static accuracyReport measureEngine(const std::function<int(const boardState &)> &chooseMove,
+                                        const boardState::player engineSide = boardState::O_PLAYER);
+    static agreementReport measureAgreement(const std::function<int(const boardState &)> &reference,
+                                            const std::function<int(const boardState &)> &candidate,
+                                            const boardState::player engineSide = boardState::O_PLAYER);
+    static void visitPositions(const std::function<void(const boardState &)> &visit,
+                               const boardState::player engineSide = boardState::O_PLAYER);
+
+    // Table entry layout
+    static constexpr uint8_t entry(const int move, const gameValue value) {
+        return static_cast<uint8_t>((move & 0x0F) | (value << 4));
+    };
+    static constexpr int entryMove(const uint8_t entry) { return entry & 0x0F; };
+    static constexpr gameValue entryValue(const uint8_t entry) { return static_cast<gameValue>(entry >> 4); };
+
+    static constexpr int base3(const uint16_t mask) {
+        int retVal = 0;
+        for(int i=boardState::TOTAL_CELLS-1; i>=0; i--){
+            retVal = retVal*3 + ((mask >> i) & 1);
+        }
+        return retVal;
+    };
+
+    static constexpr int tableIndex(const uint16_t moverMask, const uint16_t opponentMask) {
+        return base3(moverMask) + 2*base3(opponentMask);
+    };
+
+protected:
+    static int lookupIndex(const boardState &board, const boardState::player toMove);
+};
+
+#endif // PERFECTPLAY_H
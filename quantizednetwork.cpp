@@ -0,0 +1,223 @@
+#include "quantizednetwork.h"
+
+#include <QtMath>
+
+#include <cmath>
+
+const int   ROW_PADDING   = 16;    // int8 weights per SSE register
+const float SIGMOID_RANGE = 8.0f;  // sigmoid is 0 or 1 beyond this, to 3e-4
+const int   SIGMOID_STEPS = 2048;  // 128 steps per unit of z
+
+///
+/// \brief The sigmoidTables struct Sigmoid values, and the same values as hidden
+/// layer activations, sampled over [-SIGMOID_RANGE, SIGMOID_RANGE].
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+struct sigmoidTables {
+    float value[SIGMOID_STEPS + 1];
+    int16_t activation[SIGMOID_STEPS + 1];
+
+    sigmoidTables() {
+        for(int i=0; i<=SIGMOID_STEPS; i++){
+            const double z = -SIGMOID_RANGE + i*(2.0*SIGMOID_RANGE/SIGMOID_STEPS);
+            const double s = 1/(qExp(-1*z)+1);
+            value[i] = static_cast<float>(s);
+            activation[i] = static_cast<int16_t>(qRound(s*quantizedNetwork::ACTIVATION_ONE));
+        }
+    };
+};
+
+///
+/// \brief tables Returns the sigmoid tables, built on first use
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \return The tables
+///
+static const sigmoidTables &tables()
+{
+    static const sigmoidTables retVal;
+    return retVal;
+}
+
+///
+/// \brief quantizedNetwork::quantizedNetwork Default constructor, empty network
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+quantizedNetwork::quantizedNetwork()
+{
+}
+
+///
+/// \brief quantizedNetwork::quantizedNetwork Quantizes the layers of a model
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param layers Double precision layers, input layer first. Every layer takes a bias
+/// plus the outputs of the previous one.
+///
+quantizedNetwork::quantizedNetwork(const QVector<layerMatrix> &layers)
+{
+    // Cells go in as -1, 0 or 1, hidden activations as 0..ACTIVATION_ONE
+    float inputScale = 1.0f;
+
+    for(const layerMatrix &source : layers){
+        layer l;
+        l.inputs = source.inputs();
+        l.outputs = source.outputs();
+        l.stride = ((l.inputs + ROW_PADDING - 1)/ROW_PADDING)*ROW_PADDING;
+        l.weights.fill(0, l.outputs*l.stride);
+        l.scales.fill(0.0f, l.outputs);
+
+        for(int n=0; n<l.outputs; n++){
+            double maxWeight = 0.00;
+            for(int k=0; k<l.inputs; k++){
+                maxWeight = qMax(maxWeight, qAbs(source.row(k)[n]));
+            }
+            if(maxWeight==0.00){
+                continue;
+            }
+
+            const double scale = maxWeight/WEIGHT_LIMIT;
+            for(int k=0; k<l.inputs; k++){
+                l.weights[n*l.stride + k] = static_cast<int8_t>(qRound(source.row(k)[n]/scale));
+            }
+            l.scales[n] = static_cast<float>(scale)*inputScale;
+        }
+
+        mLayers.append(l);
+        inputScale = 1.0f/ACTIVATION_ONE;
+    }
+
+    tables();
+}
+
+///
+/// \brief quantizedNetwork::weightBytes Returns the memory taken by the weights and scales
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \return Size in bytes
+///
+int quantizedNetwork::weightBytes() const
+{
+    int retVal = 0;
+    for(const layer &l : mLayers){
+        retVal += l.weights.size()*static_cast<int>(sizeof(int8_t)) + l.scales.size()*static_cast<int>(sizeof(float));
+    }
+    return retVal;
+}
+
+///
+/// \brief quantizedNetwork::sigmoidIndex Returns the table entry nearest to z
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param z Neuron input
+///
+/// \return Table index
+///
+int quantizedNetwork::sigmoidIndex(const float z)
+{
+    const float position = (z + SIGMOID_RANGE)*(SIGMOID_STEPS/(2*SIGMOID_RANGE)) + 0.5f;
+    if(position<=0.0f){
+        return 0;
+    }
+    if(position>=SIGMOID_STEPS){
+        return SIGMOID_STEPS;
+    }
+    return static_cast<int>(position);
+}
+
+///
+/// \brief quantizedNetwork::sigmoid Lookup table sigmoid function
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param z Neuron input
+///
+/// \return Neuron output
+///
+double quantizedNetwork::sigmoid(const double z)
+{
+    return tables().value[sigmoidIndex(static_cast<float>(z))];
+}
+
+///
+/// \brief quantizedNetwork::evaluate Evaluates the network for a batch of boards
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param boards boardCount boards, inputs() cell values each
+/// \param boardCount Number of boards in the batch
+/// \param scores Output, outputs() neuron values per board
+///
+void quantizedNetwork::evaluate(const int *boards, const int boardCount, double *scores) const
+{
+    if(mLayers.isEmpty()){
+        return;
+    }
+
+    const sigmoidTables &t = tables();
+
+    int bufferSize = 0;
+    for(const layer &l : mLayers){
+        bufferSize = qMax(bufferSize, qMax(l.stride, l.outputs + 1));
+    }
+
+    // Two activation rows per thread, they only grow. The loops below run over
+    // whole padded rows, stale values past a layer meet zero padding weights.
+    static thread_local QVector<int16_t> tActivations;
+    if(tActivations.size()<2*bufferSize){
+        tActivations.fill(0, 2*bufferSize);
+    }
+
+    for(int b=0; b<boardCount; b++){
+        const int *cells = boards + b*inputs();
+        int16_t *in = tActivations.data();
+        int16_t *out = tActivations.data() + bufferSize;
+
+        // Input layer, bias + board cells...
+        in[0] = 1;
+        for(int k=1; k<mLayers.first().inputs; k++){
+            in[k] = static_cast<int16_t>(cells[k-1]);
+        }
+
+        for(int i=0; i<mLayers.size(); i++){
+            const layer &l = mLayers[i];
+            const bool isOutput = (i==mLayers.size() - 1);
+
+            for(int n=0; n<l.outputs; n++){
+                const int8_t *w = l.weights.constData() + n*l.stride;
+                int32_t acc = 0;
+                for(int k=0; k<l.stride; k++){
+                    acc += static_cast<int32_t>(w[k])*in[k];
+                }
+
+                const int index = sigmoidIndex(acc*l.scales[n]);
+                if(isOutput){
+                    scores[b*l.outputs + n] = t.value[index];
+                }
+                else{
+                    out[n+1] = t.activation[index];
+                }
+            }
+
+            // Bias of the next layer
+            out[0] = ACTIVATION_ONE;
+            int16_t *swap = in;
+            in = out;
+            out = swap;
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef QUANTIZEDNETWORK_H
+#define QUANTIZEDNETWORK_H
+
+#include "layermatrix.h"
+
+#include <QVector>
+
+#include <cstdint>
+
+///
+/// \brief The quantizedNetwork class
+///
+/// 8-bit copy of the move network. Every neuron keeps its weights as
+/// int8 with one float scale (max |weight| / 127), dot products are
+/// accumulated in int32 and the sigmoid is a lookup table. Hidden
+/// activations are stored as 0..255 integers, board cells go in as they
+/// are. Weights take 8 times less memory than the double layers.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class quantizedNetwork
+{
+public:
+    static const int WEIGHT_LIMIT   = 127;
+    static const int ACTIVATION_ONE = 255;
+
+    quantizedNetwork();
+    explicit quantizedNetwork(const QVector<layerMatrix> &layers);
+
+    bool isEmpty() const { return mLayers.isEmpty(); };
+    int inputs() const { return mLayers.isEmpty() ? 0 : mLayers.first().inputs - 1; };
+    int outputs() const { return mLayers.isEmpty() ? 0 : mLayers.last().outputs; };
+    int weightBytes() const;
+
+    void evaluate(const int *boards, const int boardCount, double *scores) const;
+
+    // Lookup table sigmoid, exact to about 1e-3
+    static double sigmoid(const double z);
+
+protected:
+    struct layer {
+        int inputs;             // bias included
+        int outputs;
+        int stride;             // padded inputs, one neuron per row
+        QVector<int8_t> weights;
+        QVector<float> scales;  // neuron scale times the input scale
+    };
+
+    QVector<layer> mLayers;
+
+    static int sigmoidIndex(const float z);
+};
+
+#endif // QUANTIZEDNETWORK_H
@@ -0,0 +1,88 @@
+#ifndef STATICNETWORK_H
+#define STATICNETWORK_H
+
+#include <QtMath>
+
+#include <array>
+
+///
+/// \brief The staticNetwork class
+///
+/// Move network with its layer sizes fixed at compile time: INPUTS
+/// cells plus bias, HIDDEN neurons, OUTPUTS neurons. The weights live
+/// in std::array members, so a network can be a constexpr value built
+/// into the binary. Every loop has a constant trip count, the compiler
+/// unrolls them and vectorizes the products across neurons; weights are
+/// stored transposed (one row per input) for that.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+template<int INPUTS, int HIDDEN, int OUTPUTS>
+class staticNetwork
+{
+public:
+    // One row per neuron, bias weight first, as the model files keep them
+    using hiddenTheta = std::array<std::array<double, INPUTS + 1>, HIDDEN>;
+    using outputTheta = std::array<std::array<double, HIDDEN + 1>, OUTPUTS>;
+
+    constexpr staticNetwork(const hiddenTheta &theta1, const outputTheta &theta2) : mTheta1(), mTheta2() {
+        for(int n=0; n<HIDDEN; n++){
+            for(int k=0; k<=INPUTS; k++){
+                mTheta1[k][n] = theta1[n][k];
+            }
+        }
+        for(int n=0; n<OUTPUTS; n++){
+            for(int k=0; k<=HIDDEN; k++){
+                mTheta2[k][n] = theta2[n][k];
+            }
+        }
+    };
+
+    void evaluate(const int *cells, double *scores) const;
+
+protected:
+    // Transposed, one row per input and one column per neuron, bias row first
+    std::array<std::array<double, HIDDEN>, INPUTS + 1> mTheta1;
+    std::array<std::array<double, OUTPUTS>, HIDDEN + 1> mTheta2;
+
+    static double g(const double z) { return (1/(qExp(-1*z)+1)); }; // Sigmoid function!
+};
+
+///
+/// \brief staticNetwork::evaluate Scores the moves of one board
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param cells INPUTS cell values
+/// \param scores Output, OUTPUTS neuron values
+///
+template<int INPUTS, int HIDDEN, int OUTPUTS>
+void staticNetwork<INPUTS, HIDDEN, OUTPUTS>::evaluate(const int *cells, double *scores) const
+{
+    // Hidden layer, starting from the bias weights
+    std::array<double, HIDDEN> hidden = mTheta1[0];
+    for(int k=0; k<INPUTS; k++){
+        const double x = static_cast<double>(cells[k]);
+        for(int n=0; n<HIDDEN; n++){
+            hidden[n] += mTheta1[k+1][n]*x;
+        }
+    }
+    for(int n=0; n<HIDDEN; n++){
+        hidden[n] = g(hidden[n]);
+    }
+
+    // Output layer
+    std::array<double, OUTPUTS> output = mTheta2[0];
+    for(int k=0; k<HIDDEN; k++){
+        for(int n=0; n<OUTPUTS; n++){
+            output[n] += mTheta2[k+1][n]*hidden[k];
+        }
+    }
+    for(int n=0; n<OUTPUTS; n++){
+        scores[n] = g(output[n]);
+    }
+}
+
+#endif // STATICNETWORK_H
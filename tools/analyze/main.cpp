@@ -0,0 +1,392 @@
+#include "gamerecord.h"
+#include "perfectplay.h"
+#include "virtualplayer.h"
+#include "workstealingpool.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+#include <memory>
+#include <vector>
+
+const qint64 CHUNK_GAMES = 1 << 20;  // games per pool task
+const qint8 UNKNOWN_MOVE = -2;       // facts not worked out yet
+const int POW3[boardState::TOTAL_CELLS] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+
+///
+/// \brief The positionFacts struct, what the engine and the solver say about a position
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+struct positionFacts {
+    qint8 engineMove = UNKNOWN_MOVE;
+    quint8 value = perfectPlay::NO_VALUE;
+    quint8 moveValues[boardState::TOTAL_CELLS] = {};
+};
+
+///
+/// \brief The sideTotals struct, how one side played
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+struct sideTotals {
+    qint64 positions     = 0;
+    qint64 optimalMoves  = 0;
+    qint64 winToDraw     = 0;
+    qint64 winToLoss     = 0;
+    qint64 drawToLoss    = 0;
+    qint64 engineAgrees  = 0;   // the move played is the engine move
+    qint64 engineOptimal = 0;   // the engine move is optimal
+
+    qint64 blunders() const { return winToDraw + winToLoss + drawToLoss; };
+};
+
+///
+/// \brief The openingTotals struct, games by their first move
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+struct openingTotals {
+    qint64 games      = 0;
+    qint64 xWins      = 0;
+    qint64 oWins      = 0;
+    qint64 draws      = 0;
+    qint64 unfinished = 0;
+    qint64 blunders   = 0;
+};
+
+///
+/// \brief The analysisTotals struct, results of one thread, merged at the end
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+struct analysisTotals {
+    qint64 games   = 0;
+    qint64 invalid = 0;
+    sideTotals sides[2];   // by boardState::player
+    openingTotals openings[boardState::TOTAL_CELLS];
+
+    void merge(const analysisTotals &other);
+};
+
+///
+/// \brief analysisTotals::merge Adds the results of another thread
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param other Results to add
+///
+void analysisTotals::merge(const analysisTotals &other)
+{
+    games += other.games;
+    invalid += other.invalid;
+    for(int s=0; s<2; s++){
+        sides[s].positions += other.sides[s].positions;
+        sides[s].optimalMoves += other.sides[s].optimalMoves;
+        sides[s].winToDraw += other.sides[s].winToDraw;
+        sides[s].winToLoss += other.sides[s].winToLoss;
+        sides[s].drawToLoss += other.sides[s].drawToLoss;
+        sides[s].engineAgrees += other.sides[s].engineAgrees;
+        sides[s].engineOptimal += other.sides[s].engineOptimal;
+    }
+    for(int i=0; i<boardState::TOTAL_CELLS; i++){
+        openings[i].games += other.openings[i].games;
+        openings[i].xWins += other.openings[i].xWins;
+        openings[i].oWins += other.openings[i].oWins;
+        openings[i].draws += other.openings[i].draws;
+        openings[i].unfinished += other.openings[i].unfinished;
+        openings[i].blunders += other.openings[i].blunders;
+    }
+}
+
+///
+/// \brief The gameAnalyzer class, scores games for one thread
+///
+/// There are only 3^9 boards from the side to move point of view, the
+/// engine and the solver work each one out once and keep it, so archives
+/// of any size cost no more inference than that.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class gameAnalyzer
+{
+public:
+    gameAnalyzer(const virtualPlayer::engineType engine, const networkModel &model) :
+        mFacts(perfectPlay::TABLE_SIZE) {
+        mPlayer.setEngine(engine);
+        if(!model.isEmpty()){
+            mPlayer.setModel(model);
+        }
+    };
+
+    void analyze(const gameRecord &record, analysisTotals &totals);
+
+protected:
+    virtualPlayer mPlayer;
+    std::vector<positionFacts> mFacts;  // by perfectPlay::tableIndex
+
+    const positionFacts &facts(const int index, const uint16_t moverMask, const uint16_t opponentMask);
+};
+
+///
+/// \brief gameAnalyzer::facts Engine move and move values of a position, worked out on first use
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param index perfectPlay::tableIndex of the position
+/// \param moverMask Marks of the side to move
+/// \param opponentMask Marks of the other side
+///
+/// \return The facts
+///
+const positionFacts &gameAnalyzer::facts(const int index, const uint16_t moverMask, const uint16_t opponentMask)
+{
+    positionFacts &f = mFacts[index];
+    if(f.engineMove!=UNKNOWN_MOVE){
+        return f;
+    }
+
+    // The engines play O, the side to move is shown to them as O
+    const boardState board(moverMask, opponentMask);
+    f.value = perfectPlay::positionValue(board, boardState::O_PLAYER);
+    for(int i=0; i<boardState::TOTAL_CELLS; i++){
+        f.moveValues[i] = perfectPlay::moveValue(board, boardState::O_PLAYER, i);
+    }
+    f.engineMove = static_cast<qint8>(mPlayer.chooseMove(board));
+    return f;
+}
+
+///
+/// \brief gameAnalyzer::analyze Scores every move of a game
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param record Game
+/// \param totals Results, added to
+///
+void gameAnalyzer::analyze(const gameRecord &record, analysisTotals &totals)
+{
+    boardState board;
+    boardState::player mover = record.firstPlayer;
+    int base3[2] = {0, 0};  // perfectPlay::base3 of each side, kept up to date
+    qint64 blunders = 0;
+
+    totals.games++;
+
+    for(int i=0; i<record.moveCount; i++){
+        const int move = record.moves[i];
+        if(!board.isLegal(move)){
+            totals.invalid++;
+            return;
+        }
+
+        const boardState::player opponent = (mover==boardState::X_PLAYER) ? boardState::O_PLAYER : boardState::X_PLAYER;
+        const positionFacts &f = facts(base3[mover] + 2*base3[opponent], board.mask(mover), board.mask(opponent));
+        const int played = f.moveValues[move];
+
+        sideTotals &side = totals.sides[mover];
+        side.positions++;
+        side.optimalMoves += (played==f.value) ? 1 : 0;
+        side.engineAgrees += (f.engineMove==move) ? 1 : 0;
+        side.engineOptimal += (f.engineMove>=0 && f.moveValues[f.engineMove]==f.value) ? 1 : 0;
+        if(played<f.value){
+            blunders++;
+            if(f.value==perfectPlay::WIN && played==perfectPlay::DRAW){
+                side.winToDraw++;
+            }
+            else if(f.value==perfectPlay::WIN){
+                side.winToLoss++;
+            }
+            else{
+                side.drawToLoss++;
+            }
+        }
+
+        board.play(move, mover);
+        base3[mover] += POW3[move];
+        mover = opponent;
+    }
+
+    if(record.moveCount==0){
+        return;
+    }
+
+    openingTotals &opening = totals.openings[record.moves[0]];
+    opening.games++;
+    opening.blunders += blunders;
+    switch(board.gameStatus()){
+        case boardState::X_WON:
+            opening.xWins++;
+            break;
+        case boardState::O_WON:
+            opening.oWins++;
+            break;
+        case boardState::DRAW:
+            opening.draws++;
+            break;
+        case boardState::IN_PROGRESS:
+            opening.unfinished++;
+            break;
+    };
+}
+
+///
+/// \brief printSide Prints how one side played
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param out Output stream
+/// \param name Side name
+/// \param side Results
+///
+static void printSide(QTextStream &out, const QString &name, const sideTotals &side)
+{
+    const double positions = static_cast<double>(qMax<qint64>(1, side.positions));
+
+    out << name << Qt::endl;
+    out << "  positions       : " << side.positions << Qt::endl;
+    out << "  optimal moves   : " << QString::number(100.0*side.optimalMoves/positions, 'f', 2) << "%" << Qt::endl;
+    out << "  blunders        : " << QString::number(100.0*side.blunders()/positions, 'f', 2) << "% ("
+        << side.winToDraw << " win -> draw, " << side.winToLoss << " win -> loss, "
+        << side.drawToLoss << " draw -> loss)" << Qt::endl;
+    out << "  engine agreement: " << QString::number(100.0*side.engineAgrees/positions, 'f', 2) << "%" << Qt::endl;
+    out << "  engine optimal  : " << QString::number(100.0*side.engineOptimal/positions, 'f', 2) << "%" << Qt::endl;
+}
+
+///
+/// \brief main Scores recorded games on all the cores: blunders and optimal moves by
+/// the perfect play table, agreement with a virtual player engine, and results by
+/// opening move.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param argc parameter counter
+/// \param argv parameters
+/// \return Error Code
+///
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Bulk analysis of TicTacToe game archives."));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("archives"), QStringLiteral("Game archives to analyze."));
+    QCommandLineOption engineOption(QStringLiteral("engine"),
+                                    QStringLiteral("Engine to compare with: network, quantized, table or negamax."),
+                                    QStringLiteral("name"), QStringLiteral("network"));
+    QCommandLineOption modelOption(QStringLiteral("model"), QStringLiteral("Binary network model."),
+                                   QStringLiteral("file"));
+    QCommandLineOption threadsOption(QStringLiteral("threads"), QStringLiteral("Worker threads."),
+                                     QStringLiteral("n"), QString::number(QThread::idealThreadCount()));
+    parser.addOption(engineOption);
+    parser.addOption(modelOption);
+    parser.addOption(threadsOption);
+    parser.process(app);
+
+    if(parser.positionalArguments().isEmpty()){
+        parser.showHelp(1);
+    }
+
+    const virtualPlayer::engineType engine = virtualPlayer::engineFromName(parser.value(engineOption));
+    if(!virtualPlayer::isBulkEngine(engine)){
+        qWarning() << parser.value(engineOption) << "is too slow for bulk play, not supported";
+        return 1;
+    }
+    networkModel model;
+    if(parser.isSet(modelOption) && !model.loadBinary(parser.value(modelOption))){
+        return 1;
+    }
+
+    workStealingPool pool(qMax(1, parser.value(threadsOption).toInt()));
+
+    // One analyzer and one set of results per worker, plus one for this thread
+    std::vector<std::unique_ptr<gameAnalyzer>> analyzers;
+    std::vector<analysisTotals> totals(pool.threadCount() + 1);
+    for(int i=0; i<static_cast<int>(totals.size()); i++){
+        analyzers.emplace_back(new gameAnalyzer(engine, model));
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int retVal = 0;
+    qint64 bytes = 0;
+
+    for(const QString &fileName : parser.positionalArguments()){
+        gameRecordReader reader;
+        if(!reader.open(fileName)){
+            qWarning() << reader.errorString();
+            retVal = 1;
+            continue;
+        }
+
+        // Shards start where the skipping leaves off, the workers follow the scan through the page cache
+        while(true){
+            const qint64 begin = reader.position();
+            if(reader.skip(CHUNK_GAMES)==0){
+                break;
+            }
+            const qint64 end = reader.position();
+
+            pool.submit([&pool, &reader, &analyzers, &totals, begin, end]{
+                const int worker = pool.currentWorker();
+                const int slot = (worker<0) ? pool.threadCount() : worker;
+                gameRecord record;
+                for(qint64 position=begin; position<end && reader.readAt(position, record);){
+                    analyzers[slot]->analyze(record, totals[slot]);
+                }
+            });
+        }
+        pool.wait();
+
+        if(reader.isDamaged()){
+            qWarning() << fileName << "is damaged at byte" << reader.position() << "of" << reader.size();
+            retVal = 1;
+        }
+        bytes += reader.size();
+    }
+
+    const qint64 elapsedNs = qMax<qint64>(1, timer.nsecsElapsed());
+
+    analysisTotals all;
+    for(const analysisTotals &t : totals){
+        all.merge(t);
+    }
+
+    QTextStream out(stdout);
+    printSide(out, QStringLiteral("X"), all.sides[boardState::X_PLAYER]);
+    printSide(out, QStringLiteral("O"), all.sides[boardState::O_PLAYER]);
+
+    out << "opening  games        X wins  O wins  draws   unfinished  blunders/game" << Qt::endl;
+    for(int i=0; i<boardState::TOTAL_CELLS; i++){
+        const openingTotals &o = all.openings[i];
+        const double games = static_cast<double>(qMax<qint64>(1, o.games));
+        out << QString::number(i).leftJustified(9) << QString::number(o.games).leftJustified(13)
+            << QStringLiteral("%1%").arg(100.0*o.xWins/games, 5, 'f', 1).leftJustified(8)
+            << QStringLiteral("%1%").arg(100.0*o.oWins/games, 5, 'f', 1).leftJustified(8)
+            << QStringLiteral("%1%").arg(100.0*o.draws/games, 5, 'f', 1).leftJustified(8)
+            << QStringLiteral("%1%").arg(100.0*o.unfinished/games, 5, 'f', 1).leftJustified(12)
+            << QString::number(o.blunders/games, 'f', 3) << Qt::endl;
+    }
+
+    const qint64 positions = all.sides[0].positions + all.sides[1].positions;
+    out << Qt::endl << all.games << " games (" << all.invalid << " invalid), " << positions << " positions in "
+        << QString::number(elapsedNs/1e9, 'f', 2) << " s on " << pool.threadCount() << " threads: "
+        << QString::number(positions*1e9/elapsedNs, 'f', 0) << " positions/s, "
+        << QString::number(bytes*1e3/elapsedNs, 'f', 1) << " MB/s" << Qt::endl;
+
+    return retVal;
+}
@@ -0,0 +1,132 @@
+#include "allocationcounter.h"
+
+#include <cerrno>
+#include <cstddef>
+
+// Counting state of the calling thread, plain values, nothing to allocate
+static thread_local bool tArmed = false;
+static thread_local qint64 tAllocations = 0;
+
+#if defined(__GLIBC__)
+
+extern "C" {
+
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *pointer, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void *__libc_valloc(size_t size);
+void *__libc_pvalloc(size_t size);
+
+void *malloc(size_t size)
+{
+    if(tArmed){
+        tAllocations++;
+    }
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    if(tArmed){
+        tAllocations++;
+    }
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size)
+{
+    if(tArmed){
+        tAllocations++;
+    }
+    return __libc_realloc(pointer, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+    if(tArmed){
+        tAllocations++;
+    }
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **pointer, size_t alignment, size_t size)
+{
+    if(tArmed){
+        tAllocations++;
+    }
+    *pointer = __libc_memalign(alignment, size);
+    return (*pointer==nullptr) ? ENOMEM : 0;
+}
+
+// The obsolete aligned allocators, some allocators and Qt paths still use them
+void *memalign(size_t alignment, size_t size)
+{
+    if(tArmed){
+        tAllocations++;
+    }
+    return __libc_memalign(alignment, size);
+}
+
+void *valloc(size_t size)
+{
+    if(tArmed){
+        tAllocations++;
+    }
+    return __libc_valloc(size);
+}
+
+void *pvalloc(size_t size)
+{
+    if(tArmed){
+        tAllocations++;
+    }
+    return __libc_pvalloc(size);
+}
+
+}
+
+#endif
+
+///
+/// \brief allocationCounter::isSupported Tells if allocations can be counted
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \return true on glibc builds
+///
+bool allocationCounter::isSupported()
+{
+#if defined(__GLIBC__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+///
+/// \brief allocationCounter::start Starts counting the allocations of this thread
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void allocationCounter::start()
+{
+    tAllocations = 0;
+    tArmed = true;
+}
+
+///
+/// \brief allocationCounter::stop Stops counting
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \return Allocations made by this thread since start()
+///
+qint64 allocationCounter::stop()
+{
+    tArmed = false;
+    return tAllocations;
+}
@@ -0,0 +1,26 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <QtGlobal>
+
+///
+/// \brief The allocationCounter class
+///
+/// Counts the heap allocations made by the calling thread between
+/// start() and stop(). It replaces malloc and friends of the process,
+/// forwarding them to the C library, so only builds against glibc
+/// can count.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class allocationCounter
+{
+public:
+    static bool isSupported();
+
+    static void start();
+    static qint64 stop();
+};
+
+#endif // ALLOCATIONCOUNTER_H
@@ -0,0 +1,17 @@
+QT += widgets
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+include(../../core.pri)
+
+SOURCES += \
+        allocationcounter.cpp \
+        main.cpp \
+        ../../gameboard.cpp
+
+HEADERS += \
+    allocationcounter.h \
+    ../../gameboard.h
+
+TARGET=benchmark
@@ -0,0 +1,492 @@
+#include "allocationcounter.h"
+#include "gameboard.h"
+#include "virtualplayer.h"
+#include "perfectplay.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPair>
+#include <QTextStream>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+const int ROUNDS             = 5;     // the median round is reported
+const int LATENCY_SAMPLES    = 20000; // single move calls timed one by one
+const double DEFAULT_TOLERANCE = 0.10;
+
+///
+/// \brief The benchmarkResult struct, one measured figure
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+struct benchmarkResult {
+    QString name;
+    QString unit;
+    double value;
+    bool higherIsBetter;
+};
+
+///
+/// \brief The gameBoardBenchmark class, reaches the board internals that the
+/// benchmark times. Friend of gameBoard.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class gameBoardBenchmark
+{
+public:
+    static gameBoard *create(const int rows, const int cols, const int winLength) {
+        gameBoard::setBoardSize(rows, cols, winLength);
+        return new gameBoard(nullptr);
+    };
+
+    static void destroy(gameBoard *board) { delete board; };
+    static gameSession &session(gameBoard *board) { return board->mSession; };
+    static bool getGameStatus(gameBoard *board) { return board->getGameStatus(); };
+};
+
+///
+/// \brief nsPerIteration Times a body, in rounds long enough for the clock, and
+/// returns the median round.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param body Code under test, runs once per call
+/// \param minRoundNs Minimum length of a round
+///
+/// \return Nanoseconds per iteration
+///
+static double nsPerIteration(const std::function<void()> &body, const qint64 minRoundNs)
+{
+    // Calibration, doubling until a round is long enough
+    qint64 iterations = 1;
+    QElapsedTimer timer;
+    for(;;){
+        timer.start();
+        for(qint64 i=0; i<iterations; i++){
+            body();
+        }
+        if(timer.nsecsElapsed()>=minRoundNs){
+            break;
+        }
+        iterations *= 2;
+    }
+
+    std::vector<double> rounds;
+    for(int r=0; r<ROUNDS; r++){
+        timer.start();
+        for(qint64 i=0; i<iterations; i++){
+            body();
+        }
+        rounds.push_back(static_cast<double>(timer.nsecsElapsed())/iterations);
+    }
+
+    std::sort(rounds.begin(), rounds.end());
+    return rounds[ROUNDS/2];
+}
+
+///
+/// \brief benchmarkMoves Single move latency and throughput of an engine, over every
+/// position the virtual player can face.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param results Results list
+/// \param name Engine name
+/// \param positions Positions to play
+/// \param minRoundNs Minimum length of a round
+///
+static void benchmarkMoves(QVector<benchmarkResult> &results, const QString &name,
+                           const QVector<boardState> &positions, const qint64 minRoundNs)
+{
+    virtualPlayer player;
+    player.setEngine(virtualPlayer::engineFromName(name));
+
+    int next = 0;
+    const double meanNs = nsPerIteration([&]{
+        boardState board = positions[next];
+        player.makeYourNextMove(board);
+        next = (next + 1)%positions.size();
+    }, minRoundNs);
+
+    // One by one, for the latency distribution
+    std::vector<qint64> samples(LATENCY_SAMPLES);
+    QElapsedTimer timer;
+    for(int i=0; i<LATENCY_SAMPLES; i++){
+        boardState board = positions[i%positions.size()];
+        timer.start();
+        player.makeYourNextMove(board);
+        samples[i] = timer.nsecsElapsed();
+    }
+    std::sort(samples.begin(), samples.end());
+
+    const QString prefix = QStringLiteral("move.%1.").arg(name);
+    results.append({prefix + QStringLiteral("p50"), QStringLiteral("ns"), static_cast<double>(samples[LATENCY_SAMPLES/2]), false});
+    results.append({prefix + QStringLiteral("p99"), QStringLiteral("ns"), static_cast<double>(samples[LATENCY_SAMPLES*99/100]), false});
+    results.append({prefix + QStringLiteral("throughput"), QStringLiteral("moves/s"), 1e9/meanNs, true});
+}
+
+///
+/// \brief benchmarkBatches Network throughput through the batch API
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param results Results list
+/// \param positions Positions to score
+/// \param minRoundNs Minimum length of a round
+///
+static void benchmarkBatches(QVector<benchmarkResult> &results, const QVector<boardState> &positions,
+                             const qint64 minRoundNs)
+{
+    virtualPlayer player;
+
+    for(const int batchSize : {1, 64, 1024, 16384}){
+        QVector<boardState> batch(batchSize);
+        for(int i=0; i<batchSize; i++){
+            batch[i] = positions[i%positions.size()];
+        }
+        QVector<double> scores(batchSize*boardState::TOTAL_CELLS);
+
+        const double ns = nsPerIteration([&]{
+            player.scoreBoards(batch.constData(), batchSize, scores.data());
+        }, minRoundNs);
+
+        results.append({QStringLiteral("batch.%1.throughput").arg(batchSize), QStringLiteral("boards/s"),
+                        batchSize*1e9/ns, true});
+    }
+}
+
+///
+/// \brief checkAllocations Counts the heap allocations of every engine move once
+/// the engine has warmed up, and of a single board through the batch API.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param engines Engines to check
+/// \param positions Positions to play
+/// \param out Report stream
+///
+/// \return Total allocations, 0 when move generation is allocation free
+///
+static qint64 checkAllocations(const QStringList &engines, const QVector<boardState> &positions, QTextStream &out)
+{
+    qint64 total = 0;
+
+    for(const QString &name : engines){
+        virtualPlayer player;
+        player.setEngine(virtualPlayer::engineFromName(name));
+
+        // Warm up, the first moves fill the thread workspaces and tables
+        for(const boardState &position : positions){
+            boardState board = position;
+            player.makeYourNextMove(board);
+        }
+
+        allocationCounter::start();
+        for(const boardState &position : positions){
+            boardState board = position;
+            player.makeYourNextMove(board);
+        }
+        const qint64 allocations = allocationCounter::stop();
+
+        out << "move." << name << ": " << allocations << " allocations in "
+            << positions.size() << " moves" << Qt::endl;
+        total += allocations;
+    }
+
+    virtualPlayer player;
+    double scores[boardState::TOTAL_CELLS];
+    player.scoreBoards(positions.constData(), 1, scores);
+
+    allocationCounter::start();
+    for(const boardState &position : positions){
+        player.scoreBoards(&position, 1, scores);
+    }
+    const qint64 allocations = allocationCounter::stop();
+
+    out << "batch.1: " << allocations << " allocations in " << positions.size() << " calls" << Qt::endl;
+
+    return total + allocations;
+}
+
+///
+/// \brief benchmarkStatus gameBoard::getGameStatus cost, for a game in progress, won and drawn
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param results Results list
+/// \param minRoundNs Minimum length of a round
+///
+static void benchmarkStatus(QVector<benchmarkResult> &results, const qint64 minRoundNs)
+{
+    gameBoard *board = gameBoardBenchmark::create(3, 3, 3);
+    gameSession &session = gameBoardBenchmark::session(board);
+
+    const QVector<QPair<QString, QVector<int>>> games = {
+        {QStringLiteral("in_progress"), {4, 0, 8}},
+        {QStringLiteral("won"), {0, 3, 1, 4, 2}},
+        {QStringLiteral("draw"), {0, 4, 8, 1, 7, 6, 2, 5, 3}},
+    };
+
+    for(const QPair<QString, QVector<int>> &game : games){
+        session.newGame(boardState::X_PLAYER);
+        for(const int move : game.second){
+            session.play(move);
+        }
+
+        volatile bool sink = false;
+        const double ns = nsPerIteration([&]{
+            sink = gameBoardBenchmark::getGameStatus(board);
+        }, minRoundNs);
+        Q_UNUSED(sink);
+
+        results.append({QStringLiteral("status.%1").arg(game.first), QStringLiteral("ns"), ns, false});
+    }
+
+    gameBoardBenchmark::destroy(board);
+}
+
+///
+/// \brief benchmarkPaint gameBoard::paintEvent render time on an offscreen image
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param results Results list
+/// \param minRoundNs Minimum length of a round
+///
+static void benchmarkPaint(QVector<benchmarkResult> &results, const qint64 minRoundNs)
+{
+    struct paintCase { QString name; int rows; int cols; int winLength; };
+    const QVector<paintCase> cases = { {QStringLiteral("3x3"), 3, 3, 3}, {QStringLiteral("15x15"), 15, 15, 5} };
+
+    for(const paintCase &c : cases){
+        gameBoard *board = gameBoardBenchmark::create(c.rows, c.cols, c.winLength);
+        gameSession &session = gameBoardBenchmark::session(board);
+
+        // Half full board
+        const int cells = session.board().cellCount();
+        for(int i=0; i<cells/2 && !session.isOver(); i++){
+            session.play((i*7)%cells);
+        }
+
+        QImage image(board->size(), QImage::Format_ARGB32_Premultiplied);
+        const double ns = nsPerIteration([&]{
+            board->render(&image);
+        }, minRoundNs);
+
+        results.append({QStringLiteral("paint.%1").arg(c.name), QStringLiteral("us"), ns/1000.0, false});
+        gameBoardBenchmark::destroy(board);
+    }
+}
+
+///
+/// \brief writeResults Writes the results as JSON or CSV
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param results Results list
+/// \param out Output stream
+/// \param csv true for CSV, JSON otherwise
+///
+static void writeResults(const QVector<benchmarkResult> &results, QTextStream &out, const bool csv)
+{
+    if(csv){
+        out << "name,unit,value,higher_is_better" << Qt::endl;
+        for(const benchmarkResult &r : results){
+            out << r.name << "," << r.unit << "," << QString::number(r.value, 'g', 8) << ","
+                << (r.higherIsBetter ? "1" : "0") << Qt::endl;
+        }
+        return;
+    }
+
+    QJsonArray array;
+    for(const benchmarkResult &r : results){
+        QJsonObject object;
+        object.insert(QStringLiteral("name"), r.name);
+        object.insert(QStringLiteral("unit"), r.unit);
+        object.insert(QStringLiteral("value"), r.value);
+        object.insert(QStringLiteral("higher_is_better"), r.higherIsBetter);
+        array.append(object);
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("results"), array);
+    out << QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+///
+/// \brief compareWithBaseline Regression gate, compares the results with a previous run
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param results Results list
+/// \param baselineFile JSON output of a previous run
+/// \param tolerance Allowed relative loss, 0.10 = 10%
+/// \param out Report stream
+///
+/// \return Number of regressions, -1 if the baseline cannot be read
+///
+static int compareWithBaseline(const QVector<benchmarkResult> &results, const QString &baselineFile,
+                               const double tolerance, QTextStream &out)
+{
+    QFile file(baselineFile);
+    if(!file.open(QIODevice::ReadOnly)){
+        qWarning() << "cannot open" << baselineFile << file.errorString();
+        return -1;
+    }
+
+    const QJsonArray baseline = QJsonDocument::fromJson(file.readAll()).object().value(QStringLiteral("results")).toArray();
+    int retVal = 0;
+
+    for(const benchmarkResult &r : results){
+        for(const QJsonValue &value : baseline){
+            const QJsonObject b = value.toObject();
+            if(b.value(QStringLiteral("name")).toString()!=r.name){
+                continue;
+            }
+
+            const double before = b.value(QStringLiteral("value")).toDouble();
+            const double change = (before==0.00) ? 0.00 : (r.value - before)/before;
+            const bool regressed = r.higherIsBetter ? (change < -tolerance) : (change > tolerance);
+            if(regressed){
+                retVal++;
+            }
+
+            out << (regressed ? "REGRESSION " : "ok         ") << r.name.leftJustified(28)
+                << QString::number(before, 'g', 6) << " -> " << QString::number(r.value, 'g', 6) << " " << r.unit
+                << " (" << (change>=0 ? "+" : "") << QString::number(100.0*change, 'f', 1) << "%)" << Qt::endl;
+        }
+    }
+
+    return retVal;
+}
+
+///
+/// \brief main Benchmarks the move engines, the batch API, the status checks and
+/// the board painting. Runs without a display.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param argc parameter counter
+/// \param argv parameters
+/// \return Error Code, 2 when the baseline comparison finds regressions, 3 when
+/// the allocation check finds allocations
+///
+int main(int argc, char *argv[])
+{
+    // Paint on images, no display server needed
+    if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")){
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("TicTacToe benchmarks."));
+    parser.addHelpOption();
+    QCommandLineOption formatOption(QStringLiteral("format"), QStringLiteral("Output format: json or csv."),
+                                    QStringLiteral("format"), QStringLiteral("json"));
+    QCommandLineOption outputOption(QStringList() << QStringLiteral("o") << QStringLiteral("output"),
+                                    QStringLiteral("Write the results to a file instead of stdout."),
+                                    QStringLiteral("file"));
+    QCommandLineOption baselineOption(QStringLiteral("baseline"),
+                                      QStringLiteral("JSON results of a previous build, fail on regressions."),
+                                      QStringLiteral("file"));
+    QCommandLineOption toleranceOption(QStringLiteral("tolerance"),
+                                       QStringLiteral("Allowed relative loss against the baseline."),
+                                       QStringLiteral("fraction"), QString::number(DEFAULT_TOLERANCE));
+    QCommandLineOption roundOption(QStringLiteral("round-ms"), QStringLiteral("Minimum length of a timing round."),
+                                   QStringLiteral("ms"), QStringLiteral("50"));
+    QCommandLineOption enginesOption(QStringLiteral("engines"), QStringLiteral("Comma separated engines to time."),
+                                     QStringLiteral("names"), QStringLiteral("network,quantized,table,negamax"));
+    parser.addOption(formatOption);
+    parser.addOption(outputOption);
+    parser.addOption(baselineOption);
+    parser.addOption(toleranceOption);
+    parser.addOption(roundOption);
+    QCommandLineOption allocationsOption(QStringLiteral("check-allocations"),
+                                         QStringLiteral("Count the heap allocations of warm engine moves instead of timing, fail on any."));
+    parser.addOption(enginesOption);
+    parser.addOption(allocationsOption);
+    parser.process(app);
+
+    const qint64 minRoundNs = qMax<qint64>(1, parser.value(roundOption).toLongLong())*1000000;
+
+    QVector<boardState> positions;
+    perfectPlay::visitPositions([&](const boardState &board){
+        positions.append(board);
+    });
+
+    QStringList engines;
+    for(const QString &engine : parser.value(enginesOption).split(QLatin1Char(','), Qt::SkipEmptyParts)){
+        engines.append(engine.trimmed());
+    }
+
+    if(parser.isSet(allocationsOption)){
+        QTextStream out(stdout);
+        if(!allocationCounter::isSupported()){
+            qWarning() << "allocations can only be counted on glibc builds";
+            return 1;
+        }
+        if(engines.removeAll(QStringLiteral("mcts"))>0){
+            qWarning() << "mcts allocates its search tree on every move, left out";
+        }
+        return (checkAllocations(engines, positions, out)==0) ? 0 : 3;
+    }
+
+    QVector<benchmarkResult> results;
+    for(const QString &engine : engines){
+        benchmarkMoves(results, engine, positions, minRoundNs);
+    }
+    benchmarkBatches(results, positions, minRoundNs);
+    benchmarkStatus(results, minRoundNs);
+    benchmarkPaint(results, minRoundNs);
+
+    const bool csv = (parser.value(formatOption)==QStringLiteral("csv"));
+    if(parser.isSet(outputOption)){
+        QFile file(parser.value(outputOption));
+        if(!file.open(QIODevice::WriteOnly | QIODevice::Text)){
+            qWarning() << "cannot write" << parser.value(outputOption) << file.errorString();
+            return 1;
+        }
+        QTextStream out(&file);
+        writeResults(results, out, csv);
+    }
+    else{
+        QTextStream out(stdout);
+        writeResults(results, out, csv);
+    }
+
+    if(parser.isSet(baselineOption)){
+        QTextStream report(stderr);
+        const int regressions = compareWithBaseline(results, parser.value(baselineOption),
+                                                    parser.value(toleranceOption).toDouble(), report);
+        if(regressions<0){
+            return 1;
+        }
+        if(regressions>0){
+            report << regressions << " regression(s)" << Qt::endl;
+            return 2;
+        }
+    }
+
+    return 0;
+}
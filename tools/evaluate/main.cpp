@@ -0,0 +1,111 @@
+#include "virtualplayer.h"
+#include "perfectplay.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+///
+/// \brief printReport Prints an accuracy report
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param out Output stream
+/// \param name Engine name
+/// \param report Engine accuracy report
+/// \param elapsedNs Time spent by the engine
+///
+static void printReport(QTextStream &out, const QString &name, const perfectPlay::accuracyReport &report,
+                        const qint64 elapsedNs)
+{
+    const int subOptimal = report.positions - report.optimalMoves - report.illegalMoves;
+
+    out << name << Qt::endl;
+    out << "  positions     : " << report.positions << Qt::endl;
+    out << "  optimal moves : " << report.optimalMoves
+        << " (" << QString::number(100.0*report.optimalMoves/qMax(1, report.positions), 'f', 2) << "%)" << Qt::endl;
+    out << "  sub-optimal   : " << subOptimal
+        << " (" << QString::number(100.0*subOptimal/qMax(1, report.positions), 'f', 2) << "%)" << Qt::endl;
+    out << "    win -> draw : " << report.winToDraw << Qt::endl;
+    out << "    win -> loss : " << report.winToLoss << Qt::endl;
+    out << "    draw -> loss: " << report.drawToLoss << Qt::endl;
+    out << "  illegal moves : " << report.illegalMoves << Qt::endl;
+    out << "  time per move : " << QString::number(elapsedNs/1000.0/qMax(1, report.positions), 'f', 3) << " us" << Qt::endl;
+}
+
+///
+/// \brief main Measures the virtual player engines against the perfect play table,
+/// in every position the virtual player can face.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param argc parameter counter
+/// \param argv parameters
+/// \return Error Code
+///
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Virtual player accuracy against perfect play."));
+    parser.addHelpOption();
+    QCommandLineOption engineOption(QStringLiteral("engine"),
+                                    QStringLiteral("Engine to measure: network, quantized, table, negamax or mcts."),
+                                    QStringLiteral("name"), QStringLiteral("network"));
+    QCommandLineOption modelOption(QStringLiteral("model"),
+                                   QStringLiteral("Binary network model, the built-in one by default."),
+                                   QStringLiteral("file"));
+    parser.addOption(engineOption);
+    parser.addOption(modelOption);
+    parser.process(app);
+
+    virtualPlayer player;
+    player.setEngine(virtualPlayer::engineFromName(parser.value(engineOption)));
+    if(parser.isSet(modelOption) && !player.loadModel(parser.value(modelOption))){
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const perfectPlay::accuracyReport report = perfectPlay::measureEngine([&](const boardState &board){
+        return player.chooseMove(board);
+    });
+    const qint64 elapsedNs = timer.nsecsElapsed();
+
+    QTextStream out(stdout);
+    printReport(out, parser.value(engineOption), report, elapsedNs);
+
+    if(player.engine()==virtualPlayer::NEGAMAX){
+        const negamaxSolver::searchStats stats = player.solverStats();
+        out << "  nodes         : " << stats.nodes
+            << " (" << QString::number(static_cast<double>(stats.nodes)/qMax<quint64>(1, stats.searches), 'f', 1) << " per move)" << Qt::endl;
+        out << "  TT hit rate   : " << QString::number(100.0*stats.ttHitRate(), 'f', 2) << "%" << Qt::endl;
+    }
+
+    if(player.engine()==virtualPlayer::QUANTIZED_NETWORK){
+        const perfectPlay::agreementReport agreement = perfectPlay::measureAgreement(
+            [&](const boardState &board){ return player.networkMove(board); },
+            [&](const boardState &board){ return player.quantizedMove(board); });
+        const int doubleBytes = [&]{
+            int bytes = 0;
+            for(const layerMatrix &layer : player.model().layers()){
+                bytes += layer.inputs()*layer.outputs()*static_cast<int>(sizeof(double));
+            }
+            return bytes;
+        }();
+
+        out << "  same move as the double network: " << agreement.sameMoves << " of " << agreement.positions
+            << " (" << QString::number(100.0*agreement.sameMoves/qMax(1, agreement.positions), 'f', 2) << "%)" << Qt::endl;
+        out << "    other move, same value  : " << agreement.sameValue << Qt::endl;
+        out << "    other move, better value: " << agreement.betterValue << Qt::endl;
+        out << "    other move, worse value : " << agreement.worseValue << Qt::endl;
+        out << "  weight memory : " << player.quantized().weightBytes() << " bytes ("
+            << doubleBytes << " as doubles)" << Qt::endl;
+    }
+
+    return 0;
+}
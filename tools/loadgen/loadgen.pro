@@ -0,0 +1,10 @@
+QT -= gui
+QT += network
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+SOURCES += \
+        main.cpp
+
+TARGET=loadgen
@@ -0,0 +1,263 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QHostAddress>
+#include <QLocalSocket>
+#include <QQueue>
+#include <QTcpSocket>
+#include <QTextStream>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+const int CELLS = 9;
+
+///
+/// \brief The loadResults struct, totals of all the connections
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+struct loadResults {
+    qint64 games  = 0;
+    qint64 moves  = 0;
+    qint64 errors = 0;
+    std::vector<qint64> latencies;  // ns, per move request
+    int runningClients = 0;
+};
+
+///
+/// \brief The loadClient class, one connection playing random moves in many sessions
+/// at once, one request in flight per session.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class loadClient : public QObject
+{
+public:
+    loadClient(QIODevice *socket, const int sessions, const int games, const quint64 seed,
+               const QElapsedTimer &clock, loadResults &results) :
+        mSocket(socket), mClock(clock), mResults(results), mSessions(sessions) {
+        for(int i=0; i<sessions; i++){
+            mSessions[i].gamesLeft = games;
+            mSessions[i].rng = (seed + i*0x9E3779B97F4A7C15ULL) | 1;
+        }
+        mResults.runningClients++;
+
+        connect(mSocket, &QIODevice::readyRead, this, [this]{
+            while(mSocket->canReadLine()){
+                handleResponse(mSocket->readLine().trimmed());
+            }
+        });
+    };
+
+    // Call once connected
+    void start() {
+        for(int i=0; i<static_cast<int>(mSessions.size()); i++){
+            newGame(i);
+        }
+    };
+
+protected:
+    struct session {
+        quint32 id = 0;
+        int gamesLeft = 0;
+        quint64 rng = 1;
+        qint64 sentAt = 0;
+    };
+
+    QIODevice *mSocket;
+    const QElapsedTimer &mClock;
+    loadResults &mResults;
+    std::vector<session> mSessions;
+    QQueue<int> mWaitingGame;      // sessions waiting for their GAME response, in order
+    QHash<quint32, int> mById;
+    int mDoneSessions = 0;
+
+    void newGame(const int index) {
+        session &s = mSessions[index];
+        mSocket->write((s.gamesLeft%2==0) ? "NEW\n" : "NEW O\n");
+        mWaitingGame.enqueue(index);
+    };
+
+    void handleResponse(const QByteArray &line) {
+        const QList<QByteArray> args = line.split(' ');
+
+        if(args.first()=="GAME" && args.size()>=4 && !mWaitingGame.isEmpty()){
+            const int index = mWaitingGame.dequeue();
+            mSessions[index].id = args[1].toUInt();
+            mById.insert(mSessions[index].id, index);
+            playNext(index, args[2], args[3]);
+        }
+        else if(args.first()=="BOARD" && args.size()>=5 && mById.contains(args[1].toUInt())){
+            const int index = mById.value(args[1].toUInt());
+            mResults.latencies.push_back(mClock.nsecsElapsed() - mSessions[index].sentAt);
+            mResults.moves++;
+            playNext(index, args[2], args[3]);
+        }
+        else if(args.first()=="ERROR"){
+            mResults.errors++;
+            qWarning() << "server error:" << line;
+        }
+    };
+
+    void playNext(const int index, const QByteArray &cells, const QByteArray &status) {
+        session &s = mSessions[index];
+
+        if(status!="in_progress"){
+            mResults.games++;
+            mSocket->write("END " + QByteArray::number(s.id) + "\n");
+            mById.remove(s.id);
+            if(--s.gamesLeft>0){
+                newGame(index);
+            }
+            else if(++mDoneSessions==static_cast<int>(mSessions.size())){
+                mSocket->disconnect(this);
+                if(--mResults.runningClients==0){
+                    QCoreApplication::quit();
+                }
+            }
+            return;
+        }
+
+        // Random empty cell
+        s.rng ^= s.rng << 13;
+        s.rng ^= s.rng >> 7;
+        s.rng ^= s.rng << 17;
+        int empty = 0;
+        for(int i=0; i<CELLS && i<cells.size(); i++){
+            empty += (cells[i]=='.') ? 1 : 0;
+        }
+        int pick = static_cast<int>(s.rng%static_cast<quint64>(qMax(1, empty)));
+        int cell = 0;
+        for(int i=0; i<CELLS && i<cells.size(); i++){
+            if(cells[i]=='.' && pick--==0){
+                cell = i;
+                break;
+            }
+        }
+
+        s.sentAt = mClock.nsecsElapsed();
+        mSocket->write("MOVE " + QByteArray::number(s.id) + " " + QByteArray::number(cell) + "\n");
+    };
+};
+
+///
+/// \brief percentile Sorted sample at a percentile
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param sorted Sorted samples
+/// \param p Percentile, 0 to 100
+///
+/// \return The sample, 0 if there are none
+///
+static qint64 percentile(const std::vector<qint64> &sorted, const int p)
+{
+    return sorted.empty() ? 0 : sorted[qMin(sorted.size() - 1, sorted.size()*p/100)];
+}
+
+///
+/// \brief main Load generator for tools/server: many connections, many sessions each,
+/// random user moves. Prints the throughput and the move latency.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param argc parameter counter
+/// \param argv parameters
+/// \return Error Code
+///
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Load generator for the TicTacToe game server."));
+    parser.addHelpOption();
+    QCommandLineOption socketOption(QStringLiteral("socket"), QStringLiteral("Local socket name."),
+                                    QStringLiteral("name"), QStringLiteral("tictactoe"));
+    QCommandLineOption portOption(QStringLiteral("port"), QStringLiteral("Connect to this TCP port of localhost instead."),
+                                  QStringLiteral("port"));
+    QCommandLineOption connectionsOption(QStringLiteral("connections"), QStringLiteral("Client connections."),
+                                         QStringLiteral("n"), QStringLiteral("16"));
+    QCommandLineOption sessionsOption(QStringLiteral("sessions"), QStringLiteral("Games played at once per connection."),
+                                      QStringLiteral("n"), QStringLiteral("64"));
+    QCommandLineOption gamesOption(QStringLiteral("games"), QStringLiteral("Games per session."),
+                                   QStringLiteral("n"), QStringLiteral("100"));
+    QCommandLineOption seedOption(QStringLiteral("seed"), QStringLiteral("Random seed."),
+                                  QStringLiteral("n"), QStringLiteral("1"));
+    parser.addOption(socketOption);
+    parser.addOption(portOption);
+    parser.addOption(connectionsOption);
+    parser.addOption(sessionsOption);
+    parser.addOption(gamesOption);
+    parser.addOption(seedOption);
+    parser.process(app);
+
+    const int connections = qMax(1, parser.value(connectionsOption).toInt());
+    const int sessions = qMax(1, parser.value(sessionsOption).toInt());
+    const int games = qMax(1, parser.value(gamesOption).toInt());
+    const quint64 seed = parser.value(seedOption).toULongLong();
+
+    QElapsedTimer clock;
+    clock.start();
+    loadResults results;
+    std::vector<std::unique_ptr<loadClient>> clients;
+    int exitCode = 0;
+
+    for(int c=0; c<connections; c++){
+        QIODevice *socket = nullptr;
+        if(parser.isSet(portOption)){
+            QTcpSocket *tcp = new QTcpSocket(&app);
+            tcp->connectToHost(QHostAddress::LocalHost, static_cast<quint16>(parser.value(portOption).toUInt()));
+            if(!tcp->waitForConnected()){
+                qWarning() << "cannot connect:" << tcp->errorString();
+                return 1;
+            }
+            tcp->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            QObject::connect(tcp, &QTcpSocket::disconnected, [&]{ exitCode = 1; app.quit(); });
+            socket = tcp;
+        }
+        else{
+            QLocalSocket *local = new QLocalSocket(&app);
+            local->connectToServer(parser.value(socketOption));
+            if(!local->waitForConnected()){
+                qWarning() << "cannot connect:" << local->errorString();
+                return 1;
+            }
+            QObject::connect(local, &QLocalSocket::disconnected, [&]{ exitCode = 1; app.quit(); });
+            socket = local;
+        }
+        clients.emplace_back(new loadClient(socket, sessions, games, seed + c*0xBF58476D1CE4E5B9ULL, clock, results));
+    }
+
+    clock.restart();
+    for(std::unique_ptr<loadClient> &client : clients){
+        client->start();
+    }
+    app.exec();
+    const qint64 elapsedNs = qMax<qint64>(1, clock.nsecsElapsed());
+
+    if(exitCode!=0){
+        qWarning() << "the server closed a connection";
+    }
+
+    std::sort(results.latencies.begin(), results.latencies.end());
+
+    QTextStream out(stdout);
+    out << connections << " connections x " << sessions << " sessions: "
+        << results.games << " games, " << results.moves << " moves, " << results.errors << " errors in "
+        << QString::number(elapsedNs/1e9, 'f', 2) << " s" << Qt::endl;
+    out << QString::number(results.games*1e9/elapsedNs, 'f', 0) << " games/s, "
+        << QString::number(results.moves*1e9/elapsedNs, 'f', 0) << " moves/s" << Qt::endl;
+    out << "move latency p50 " << QString::number(percentile(results.latencies, 50)/1000.0, 'f', 1)
+        << " us, p99 " << QString::number(percentile(results.latencies, 99)/1000.0, 'f', 1) << " us" << Qt::endl;
+
+    return (exitCode!=0 || results.errors>0) ? 1 : 0;
+}
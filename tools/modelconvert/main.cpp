@@ -0,0 +1,56 @@
+#include "networkmodel.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+
+///
+/// \brief main Converts theta CSV files, one per layer, to the binary model format
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param argc parameter counter
+/// \param argv parameters
+/// \return Error Code
+///
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Network weights converter, theta CSV files to binary model."));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("layers"), QStringLiteral("Theta CSV files, input layer first (t1.csv t2.csv)."),
+                                 QStringLiteral("layers..."));
+    QCommandLineOption outputOption(QStringList() << QStringLiteral("o") << QStringLiteral("output"),
+                                    QStringLiteral("Binary model file to write."),
+                                    QStringLiteral("file"), QStringLiteral("tictactoe.model"));
+    parser.addOption(outputOption);
+    parser.process(app);
+
+    const QStringList layerFiles = parser.positionalArguments();
+    if(layerFiles.isEmpty()){
+        parser.showHelp(1);
+    }
+
+    networkModel model;
+    if(!model.loadCsv(layerFiles) || !model.saveBinary(parser.value(outputOption))){
+        return 1;
+    }
+
+    // Read it back, so a bad file never ships
+    networkModel check;
+    if(!check.loadBinary(parser.value(outputOption))){
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    out << parser.value(outputOption) << ":";
+    for(const layerMatrix &layer : check.layers()){
+        out << " " << layer.inputs() << "x" << layer.outputs();
+    }
+    out << Qt::endl;
+
+    return 0;
+}
@@ -0,0 +1,11 @@
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+include(../../core.pri)
+
+SOURCES += \
+        main.cpp
+
+TARGET=modelconvert
@@ -0,0 +1,303 @@
+#include "boardstate.h"
+#include "mnkboard.h"
+#include "workstealingpool.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QScopedPointer>
+#include <QSet>
+#include <QTextStream>
+
+#include <vector>
+
+const int TT_STRIPES  = 256;       // transposition set locks
+const int SPLIT_TASKS = 64;        // subtrees per thread, at least, for the stealing to balance
+const int CLASSIC_PLIES = boardState::TOTAL_CELLS + 1;
+
+// Known 3 x 3 totals, by ply: every position reached, and the distinct ones
+const qint64 CLASSIC_NODES[CLASSIC_PLIES]  = {1, 9, 72, 504, 3024, 15120, 54720, 148176, 200448, 127872};
+const qint64 CLASSIC_UNIQUE[CLASSIC_PLIES] = {1, 9, 72, 252, 756, 1260, 1520, 1140, 390, 78};
+const qint64 CLASSIC_GAMES = 255168;
+
+// Position hash keys, by cell and player
+static quint64 ZOBRIST[mnkBoard::MAX_CELLS][2];
+
+///
+/// \brief The perftCounters struct, per ply counts of one thread
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+struct perftCounters {
+    std::vector<qint64> nodes;
+    std::vector<qint64> xWins;
+    std::vector<qint64> oWins;
+    std::vector<qint64> draws;
+
+    explicit perftCounters(const int plies) : nodes(plies, 0), xWins(plies, 0), oWins(plies, 0), draws(plies, 0) {};
+};
+
+///
+/// \brief The transpositionSet class, position hashes seen so far, shared by all the threads
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class transpositionSet
+{
+public:
+    // true if the position was not there
+    bool insert(const quint64 key) {
+        stripe &s = mStripes[key % TT_STRIPES];
+        QMutexLocker ml(&s.mutex);
+        const int before = s.keys.size();
+        s.keys.insert(key);
+        return s.keys.size()!=before;
+    };
+
+protected:
+    struct stripe {
+        QMutex mutex;
+        QSet<quint64> keys;
+    };
+
+    stripe mStripes[TT_STRIPES];
+};
+
+///
+/// \brief cellsOf Cells of a board, for both board representations
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+static int cellsOf(const boardState &) { return boardState::TOTAL_CELLS; }
+static int cellsOf(const mnkBoard &board) { return board.cellCount(); }
+
+///
+/// \brief The perftSearch class, counts the game tree of a board representation
+///
+/// Plies below the split ply hand every child to the pool as a task, the
+/// deeper ones are walked depth first in place with play and undo.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+template<class BOARD>
+class perftSearch
+{
+public:
+    perftSearch(workStealingPool &pool, std::vector<perftCounters> &counters, transpositionSet *transpositions,
+                const int depth, const int splitPly) :
+        mPool(pool), mCounters(counters), mTranspositions(transpositions), mDepth(depth), mSplitPly(splitPly) {};
+
+    void run(const BOARD &board) {
+        submit(board, 0, 0, boardState::X_PLAYER);
+        mPool.wait();
+    };
+
+protected:
+    workStealingPool &mPool;
+    std::vector<perftCounters> &mCounters;
+    transpositionSet *mTranspositions;
+    const int mDepth;
+    const int mSplitPly;
+
+    void submit(const BOARD &board, const int ply, const quint64 hash, const boardState::player toMove) {
+        mPool.submit([this, board, ply, hash, toMove]{
+            const int worker = mPool.currentWorker();
+            BOARD copy = board;
+            visit(copy, ply, hash, toMove, mCounters[(worker<0) ? mPool.threadCount() : worker]);
+        });
+    };
+
+    void visit(BOARD &board, const int ply, const quint64 hash, const boardState::player toMove, perftCounters &counters);
+};
+
+///
+/// \brief perftSearch::visit Counts a node and its subtree
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Position, restored on return
+/// \param ply Moves played
+/// \param hash Position hash
+/// \param toMove Side to move
+/// \param counters Counts of the running thread
+///
+template<class BOARD>
+void perftSearch<BOARD>::visit(BOARD &board, const int ply, const quint64 hash, const boardState::player toMove,
+                               perftCounters &counters)
+{
+    if(mTranspositions!=nullptr && !mTranspositions->insert(hash)){
+        return;
+    }
+
+    counters.nodes[ply]++;
+    switch(board.gameStatus()){
+        case boardState::X_WON:
+            counters.xWins[ply]++;
+            return;
+        case boardState::O_WON:
+            counters.oWins[ply]++;
+            return;
+        case boardState::DRAW:
+            counters.draws[ply]++;
+            return;
+        case boardState::IN_PROGRESS:
+            break;
+    };
+    if(ply==mDepth){
+        return;
+    }
+
+    const boardState::player next = (toMove==boardState::X_PLAYER) ? boardState::O_PLAYER : boardState::X_PLAYER;
+    const int cells = cellsOf(board);
+
+    for(int i=0; i<cells; i++){
+        if(!board.isLegal(i)){
+            continue;
+        }
+        if(ply<mSplitPly){
+            BOARD child = board;
+            child.play(i, toMove);
+            submit(child, ply + 1, hash ^ ZOBRIST[i][toMove], next);
+        }
+        else{
+            board.play(i, toMove);
+            visit(board, ply + 1, hash ^ ZOBRIST[i][toMove], next, counters);
+            board.undo(i);
+        }
+    }
+}
+
+///
+/// \brief main Counts every game and position of the m,n,k rules to a depth, on all
+/// the cores. 3 x 3 counts are checked against the known totals.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param argc parameter counter
+/// \param argv parameters
+/// \return Error Code
+///
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Game tree enumeration of the m,n,k rules."));
+    parser.addHelpOption();
+    QCommandLineOption rowsOption(QStringLiteral("rows"), QStringLiteral("Board rows (m), up to 19."),
+                                  QStringLiteral("m"), QStringLiteral("3"));
+    QCommandLineOption colsOption(QStringLiteral("cols"), QStringLiteral("Board columns (n), up to 19."),
+                                  QStringLiteral("n"), QStringLiteral("3"));
+    QCommandLineOption winOption(QStringLiteral("k"), QStringLiteral("Marks in a row needed to win."),
+                                 QStringLiteral("k"), QStringLiteral("3"));
+    QCommandLineOption depthOption(QStringLiteral("depth"), QStringLiteral("Plies to count, the whole game by default."),
+                                   QStringLiteral("plies"));
+    QCommandLineOption uniqueOption(QStringLiteral("unique"),
+                                    QStringLiteral("Count distinct positions only, through a transposition hash."));
+    QCommandLineOption rulesOption(QStringLiteral("rules"),
+                                   QStringLiteral("Board representation: mnk, or bitboard (3 x 3 only)."),
+                                   QStringLiteral("name"), QStringLiteral("mnk"));
+    QCommandLineOption threadsOption(QStringLiteral("threads"), QStringLiteral("Worker threads."),
+                                     QStringLiteral("n"), QString::number(QThread::idealThreadCount()));
+    parser.addOption(rowsOption);
+    parser.addOption(colsOption);
+    parser.addOption(winOption);
+    parser.addOption(depthOption);
+    parser.addOption(uniqueOption);
+    parser.addOption(rulesOption);
+    parser.addOption(threadsOption);
+    parser.process(app);
+
+    const mnkBoard board(qBound(1, parser.value(rowsOption).toInt(), mnkBoard::MAX_SIDE),
+                         qBound(1, parser.value(colsOption).toInt(), mnkBoard::MAX_SIDE),
+                         qMax(1, parser.value(winOption).toInt()));
+    const int depth = parser.isSet(depthOption) ? qBound(0, parser.value(depthOption).toInt(), board.cellCount())
+                                                : board.cellCount();
+    const bool bitboard = (parser.value(rulesOption)==QStringLiteral("bitboard"));
+    if(bitboard && !board.isClassic()){
+        qWarning() << "the bitboard rules only play 3 x 3";
+        return 1;
+    }
+
+    quint64 seed = 0x9E3779B97F4A7C15ULL;
+    for(int i=0; i<mnkBoard::MAX_CELLS; i++){
+        for(int p=0; p<2; p++){
+            // splitmix64
+            quint64 z = (seed += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+            ZOBRIST[i][p] = z ^ (z >> 31);
+        }
+    }
+
+    workStealingPool pool(qMax(1, parser.value(threadsOption).toInt()));
+
+    // Split where there are enough subtrees to keep every thread busy
+    int splitPly = 0;
+    for(qint64 subtrees=1; splitPly<depth && subtrees<qint64(SPLIT_TASKS)*pool.threadCount(); splitPly++){
+        subtrees *= board.cellCount() - splitPly;
+    }
+
+    std::vector<perftCounters> counters(pool.threadCount() + 1, perftCounters(depth + 1));
+    QScopedPointer<transpositionSet> transpositions(parser.isSet(uniqueOption) ? new transpositionSet : nullptr);
+
+    QElapsedTimer timer;
+    timer.start();
+    if(bitboard){
+        perftSearch<boardState>(pool, counters, transpositions.data(), depth, splitPly).run(boardState());
+    }
+    else{
+        perftSearch<mnkBoard>(pool, counters, transpositions.data(), depth, splitPly).run(board);
+    }
+    const qint64 elapsedNs = qMax<qint64>(1, timer.nsecsElapsed());
+
+    perftCounters total(depth + 1);
+    for(const perftCounters &c : counters){
+        for(int ply=0; ply<=depth; ply++){
+            total.nodes[ply] += c.nodes[ply];
+            total.xWins[ply] += c.xWins[ply];
+            total.oWins[ply] += c.oWins[ply];
+            total.draws[ply] += c.draws[ply];
+        }
+    }
+
+    QTextStream out(stdout);
+    out << "ply  " << QString::fromLatin1(transpositions.isNull() ? "nodes" : "positions").leftJustified(16)
+        << QStringLiteral("X wins").leftJustified(14) << QStringLiteral("O wins").leftJustified(14) << "draws" << Qt::endl;
+
+    qint64 nodes = 0;
+    qint64 games = 0;
+    bool verified = board.isClassic();
+    for(int ply=0; ply<=depth; ply++){
+        out << QString::number(ply).leftJustified(5) << QString::number(total.nodes[ply]).leftJustified(16)
+            << QString::number(total.xWins[ply]).leftJustified(14) << QString::number(total.oWins[ply]).leftJustified(14)
+            << total.draws[ply] << Qt::endl;
+        nodes += total.nodes[ply];
+        games += total.xWins[ply] + total.oWins[ply] + total.draws[ply];
+
+        if(board.isClassic() && total.nodes[ply]!=(transpositions.isNull() ? CLASSIC_NODES[ply] : CLASSIC_UNIQUE[ply])){
+            verified = false;
+        }
+    }
+    if(board.isClassic() && transpositions.isNull() && depth==boardState::TOTAL_CELLS && games!=CLASSIC_GAMES){
+        verified = false;
+    }
+
+    out << Qt::endl << nodes << " nodes, " << games << " finished games in "
+        << QString::number(elapsedNs/1e9, 'f', 3) << " s on " << pool.threadCount() << " threads: "
+        << QString::number(nodes*1e9/elapsedNs, 'f', 0) << " nodes/s" << Qt::endl;
+
+    if(board.isClassic()){
+        out << (verified ? "3 x 3 totals verified" : "3 x 3 totals DO NOT MATCH the known ones") << Qt::endl;
+        return verified ? 0 : 2;
+    }
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include "gamerecord.h"
+#include "gamesession.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+const char *OUTCOME_NAMES[] = {"row", "column", "diagonal", "diagonal", "draw", "unfinished"};
+
+///
+/// \brief The replayTotals struct, what the archives hold
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+struct replayTotals {
+    qint64 games      = 0;
+    qint64 moves      = 0;
+    qint64 xWins      = 0;
+    qint64 oWins      = 0;
+    qint64 draws      = 0;
+    qint64 unfinished = 0;
+    qint64 invalid    = 0;   // illegal move, or an outcome the rules disagree with
+};
+
+///
+/// \brief replayGame Plays a recorded game through the rules
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param session Rules, the game is played on it
+/// \param record Game
+///
+/// \return false if a move is illegal or the recorded outcome is not the real one
+///
+static bool replayGame(gameSession &session, const gameRecord &record)
+{
+    session.newGame(record.firstPlayer);
+    for(int i=0; i<record.moveCount; i++){
+        if(!session.play(record.moves[i])){
+            return false;
+        }
+    }
+    return gameRecord::outcomeOf(session.board())==record.result;
+}
+
+///
+/// \brief gameText One game as text: first player, cells played and outcome
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param record Game
+///
+/// \return The text
+///
+static QString gameText(const gameRecord &record)
+{
+    QString text = (record.firstPlayer==boardState::X_PLAYER) ? QStringLiteral("X:") : QStringLiteral("O:");
+    for(int i=0; i<record.moveCount; i++){
+        text += QLatin1Char(' ') + QString::number(record.moves[i]);
+    }
+    return text + QStringLiteral(" -> ") + QLatin1String(OUTCOME_NAMES[record.result]);
+}
+
+///
+/// \brief main Replays game archives through the headless rules, checks them and
+/// counts the results.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param argc parameter counter
+/// \param argv parameters
+/// \return Error Code
+///
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Replays and checks TicTacToe game archives."));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("archives"), QStringLiteral("Game archives to read."));
+    QCommandLineOption showOption(QStringLiteral("show"), QStringLiteral("Print the first n games."),
+                                  QStringLiteral("n"), QStringLiteral("0"));
+    parser.addOption(showOption);
+    parser.process(app);
+
+    if(parser.positionalArguments().isEmpty()){
+        parser.showHelp(1);
+    }
+
+    QTextStream out(stdout);
+    const qint64 show = parser.value(showOption).toLongLong();
+    replayTotals totals;
+    gameSession session;
+    gameRecord record;
+    int retVal = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for(const QString &fileName : parser.positionalArguments()){
+        gameRecordReader reader;
+        if(!reader.open(fileName)){
+            qWarning() << reader.errorString();
+            retVal = 1;
+            continue;
+        }
+
+        while(reader.next(record)){
+            if(totals.games<show){
+                out << gameText(record) << Qt::endl;
+            }
+            totals.games++;
+            totals.moves += record.moveCount;
+
+            if(!replayGame(session, record)){
+                totals.invalid++;
+                continue;
+            }
+            switch(session.status()){
+                case boardState::X_WON:
+                    totals.xWins++;
+                    break;
+                case boardState::O_WON:
+                    totals.oWins++;
+                    break;
+                case boardState::DRAW:
+                    totals.draws++;
+                    break;
+                case boardState::IN_PROGRESS:
+                    totals.unfinished++;
+                    break;
+            };
+        }
+
+        if(reader.isDamaged()){
+            qWarning() << fileName << "is damaged at byte" << reader.position() << "of" << reader.size();
+            retVal = 1;
+        }
+    }
+
+    const qint64 elapsedNs = qMax<qint64>(1, timer.nsecsElapsed());
+
+    out << totals.games << " games, " << totals.moves << " moves: "
+        << totals.xWins << " X wins, " << totals.oWins << " O wins, " << totals.draws << " draws, "
+        << totals.unfinished << " unfinished, " << totals.invalid << " invalid" << Qt::endl;
+    out << "replayed in " << QString::number(elapsedNs/1e9, 'f', 2) << " s, "
+        << QString::number(totals.games*1e9/elapsedNs, 'f', 0) << " games/s" << Qt::endl;
+
+    return (totals.invalid>0) ? 1 : retVal;
+}
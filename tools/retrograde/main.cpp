@@ -0,0 +1,309 @@
+#include "endgamedatabase.h"
+#include "perfectplay.h"
+#include "workstealingpool.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QtAlgorithms>
+#include <QtMath>
+
+#include <climits>
+#include <cstring>
+#include <vector>
+
+const quint64 CHUNK_POSITIONS = 1 << 16;  // positions per pool task, a multiple of 4
+
+///
+/// \brief The retrogradeSolver class, values every position of an m,n,k board
+///
+/// Every move adds a mark, so the children of a position are all in the
+/// next layer of the index. Layers are solved from the full board back
+/// to the empty one, each one split in chunks over the pool; the values
+/// of a layer only read the layer solved before. Chunks own whole bytes
+/// of the 2-bit value array, the few positions sharing a byte with the
+/// next layer are solved after the pool is done.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class retrogradeSolver
+{
+public:
+    retrogradeSolver(const int rows, const int cols, const int winLength, const bool distances) :
+        mIndex(rows*cols), mCells(rows*cols), mLines(endgameDatabase::winLines(rows, cols, winLength)),
+        mValues((mIndex.size() + 3)/4, 0), mDistances(distances ? mIndex.size() : 0, 0) {};
+
+    const endgameDatabase::positionIndex &index() const { return mIndex; };
+
+    void solveLayer(workStealingPool &pool, const int marks);
+    endgameDatabase::gameValue value(const quint64 index) const {
+        return static_cast<endgameDatabase::gameValue>((mValues[index >> 2] >> ((index & 3)*2)) & 3);
+    };
+    bool save(const QString &fileName, const int rows, const int cols, const int winLength, QString &error) const;
+
+protected:
+    endgameDatabase::positionIndex mIndex;
+    const int mCells;
+    const QVector<quint64> mLines;
+    std::vector<uchar> mValues;
+    std::vector<uchar> mDistances;
+
+    bool hasLine(const quint64 cells) const {
+        for(const quint64 line : mLines){
+            if((cells & line)==line){
+                return true;
+            }
+        }
+        return false;
+    };
+
+    void solvePosition(const quint64 index);
+};
+
+///
+/// \brief retrogradeSolver::solvePosition Values a position from its children, the
+/// next layer must be solved.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param index Position index
+///
+void retrogradeSolver::solvePosition(const quint64 index)
+{
+    quint64 mover = 0;
+    quint64 opponent = 0;
+    mIndex.unrank(index, mover, opponent);
+
+    endgameDatabase::gameValue result = endgameDatabase::DRAW;
+    int plies = 0;
+
+    if(hasLine(mover)){
+        // The side to move cannot have won already
+        result = endgameDatabase::NO_VALUE;
+    }
+    else if(hasLine(opponent)){
+        result = endgameDatabase::LOSS;
+    }
+    else if(qPopulationCount(mover | opponent)<mCells){
+        int winPlies = INT_MAX;
+        int lossPlies = -1;
+        bool draw = false;
+
+        for(int i=0; i<mCells; i++){
+            const quint64 cell = quint64(1) << i;
+            if((mover | opponent) & cell){
+                continue;
+            }
+
+            // The opponent moves next
+            const quint64 child = mIndex.rank(opponent, mover | cell);
+            const int childPlies = mDistances.empty() ? 0 : mDistances[child];
+            switch(value(child)){
+                case endgameDatabase::LOSS:
+                    winPlies = qMin(winPlies, childPlies + 1);
+                    break;
+                case endgameDatabase::DRAW:
+                    draw = true;
+                    break;
+                case endgameDatabase::WIN:
+                    lossPlies = qMax(lossPlies, childPlies + 1);
+                    break;
+                case endgameDatabase::NO_VALUE:
+                    break;
+            };
+        }
+
+        if(winPlies!=INT_MAX){
+            result = endgameDatabase::WIN;
+            plies = winPlies;
+        }
+        else if(draw || lossPlies<0){
+            result = endgameDatabase::DRAW;
+        }
+        else{
+            result = endgameDatabase::LOSS;
+            plies = lossPlies;
+        }
+    }
+
+    mValues[index >> 2] |= static_cast<uchar>(result << ((index & 3)*2));
+    if(!mDistances.empty()){
+        mDistances[index] = static_cast<uchar>(plies);
+    }
+}
+
+///
+/// \brief retrogradeSolver::solveLayer Values all the positions with a number of marks
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param pool Workers
+/// \param marks Marks on the board
+///
+void retrogradeSolver::solveLayer(workStealingPool &pool, const int marks)
+{
+    const quint64 begin = mIndex.layerOffset(marks);
+    const quint64 end = begin + mIndex.layerSize(marks);
+    const quint64 shared = qMax(begin, end & ~quint64(3));  // first position sharing its byte with the next layer
+
+    for(quint64 first=begin; first<shared;){
+        const quint64 last = qMin(shared, (first/CHUNK_POSITIONS + 1)*CHUNK_POSITIONS);
+        pool.submit([this, first, last]{
+            for(quint64 i=first; i<last; i++){
+                solvePosition(i);
+            }
+        });
+        first = last;
+    }
+    pool.wait();
+
+    for(quint64 i=shared; i<end; i++){
+        solvePosition(i);
+    }
+}
+
+///
+/// \brief retrogradeSolver::save Writes the database file
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param fileName Database file
+/// \param rows Board rows
+/// \param cols Board columns
+/// \param winLength Marks in a row needed to win
+/// \param error Returns the error
+///
+/// \return false on error
+///
+bool retrogradeSolver::save(const QString &fileName, const int rows, const int cols, const int winLength,
+                            QString &error) const
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+        error = file.errorString();
+        return false;
+    }
+
+    char header[endgameDatabase::HEADER_SIZE] = {};
+    memcpy(header, endgameDatabase::FILE_MAGIC, 4);
+    header[4] = static_cast<char>(endgameDatabase::FILE_VERSION);
+    header[5] = static_cast<char>(rows);
+    header[6] = static_cast<char>(cols);
+    header[7] = static_cast<char>(winLength);
+    header[8] = static_cast<char>(mDistances.empty() ? 0 : endgameDatabase::HAS_DISTANCES);
+    for(int i=0; i<8; i++){
+        header[12 + i] = static_cast<char>((mIndex.size() >> (8*i)) & 0xFF);
+    }
+
+    const bool written = file.write(header, sizeof(header))==sizeof(header) &&
+                         file.write(reinterpret_cast<const char*>(mValues.data()), mValues.size())==qint64(mValues.size()) &&
+                         file.write(reinterpret_cast<const char*>(mDistances.data()), mDistances.size())==qint64(mDistances.size());
+    if(!written){
+        error = file.errorString();
+    }
+    return written;
+}
+
+///
+/// \brief main Solves every position of an m,n,k board by retrograde analysis and writes
+/// the database the game maps with --endgame. 3 x 3 results are checked against the
+/// perfect play table.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param argc parameter counter
+/// \param argv parameters
+/// \return Error Code
+///
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Retrograde solver, writes an endgame database."));
+    parser.addHelpOption();
+    QCommandLineOption outputOption(QStringList() << QStringLiteral("o") << QStringLiteral("output"),
+                                    QStringLiteral("Database file to write."),
+                                    QStringLiteral("file"), QStringLiteral("endgame.db"));
+    QCommandLineOption rowsOption(QStringLiteral("rows"), QStringLiteral("Board rows (m)."),
+                                  QStringLiteral("m"), QStringLiteral("4"));
+    QCommandLineOption colsOption(QStringLiteral("cols"), QStringLiteral("Board columns (n)."),
+                                  QStringLiteral("n"), QStringLiteral("4"));
+    QCommandLineOption winOption(QStringLiteral("k"), QStringLiteral("Marks in a row needed to win."),
+                                 QStringLiteral("k"), QStringLiteral("4"));
+    QCommandLineOption noDistancesOption(QStringLiteral("no-distances"),
+                                         QStringLiteral("Values only, a fifth of the size, moves no longer prefer quick wins."));
+    QCommandLineOption threadsOption(QStringLiteral("threads"), QStringLiteral("Worker threads."),
+                                     QStringLiteral("n"), QString::number(QThread::idealThreadCount()));
+    parser.addOption(outputOption);
+    parser.addOption(rowsOption);
+    parser.addOption(colsOption);
+    parser.addOption(winOption);
+    parser.addOption(noDistancesOption);
+    parser.addOption(threadsOption);
+    parser.process(app);
+
+    const int rows = qMax(1, parser.value(rowsOption).toInt());
+    const int cols = qMax(1, parser.value(colsOption).toInt());
+    const int winLength = qMax(1, parser.value(winOption).toInt());
+    if(rows*cols>endgameDatabase::MAX_CELLS){
+        qWarning() << "boards up to" << endgameDatabase::MAX_CELLS << "cells only";
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    retrogradeSolver solver(rows, cols, winLength, !parser.isSet(noDistancesOption));
+    const quint64 positions = solver.index().size();
+    out << positions << " positions (" << QString::number(100.0*positions/qPow(3, rows*cols), 'f', 1)
+        << "% of 3^" << rows*cols << ")" << Qt::endl;
+
+    workStealingPool pool(qMax(1, parser.value(threadsOption).toInt()));
+    QElapsedTimer timer;
+    timer.start();
+
+    for(int marks=rows*cols; marks>=0; marks--){
+        solver.solveLayer(pool, marks);
+        out << "layer " << marks << ": " << solver.index().layerSize(marks) << " positions, "
+            << QString::number(timer.elapsed()/1000.0, 'f', 2) << " s" << Qt::endl;
+    }
+
+    static const char *VALUE_NAMES[] = {"loses", "draws", "wins"};
+    out << "the first player " << VALUE_NAMES[solver.value(0)] << ", solved in "
+        << QString::number(timer.elapsed()/1000.0, 'f', 2) << " s on " << pool.threadCount() << " threads" << Qt::endl;
+
+    int retVal = 0;
+    if(rows==3 && cols==3 && winLength==3){
+        int mismatches = 0;
+        for(quint64 i=0; i<positions; i++){
+            quint64 mover = 0;
+            quint64 opponent = 0;
+            solver.index().unrank(i, mover, opponent);
+
+            // The table is indexed from the side to move point of view too
+            const boardState board(static_cast<uint16_t>(mover), static_cast<uint16_t>(opponent));
+            const perfectPlay::gameValue expected = perfectPlay::positionValue(board, boardState::O_PLAYER);
+            if(expected!=perfectPlay::NO_VALUE && !board.isOver() && static_cast<int>(expected)!=solver.value(i)){
+                mismatches++;
+            }
+        }
+        out << "perfect play table check: " << mismatches << " mismatches" << Qt::endl;
+        retVal = (mismatches==0) ? 0 : 2;
+    }
+
+    QString error;
+    if(!solver.save(parser.value(outputOption), rows, cols, winLength, error)){
+        qWarning() << "cannot write the database:" << error;
+        return 1;
+    }
+    out << "database written to " << parser.value(outputOption) << Qt::endl;
+
+    return retVal;
+}
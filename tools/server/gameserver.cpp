@@ -0,0 +1,399 @@
+#include "gameserver.h"
+#include "virtualplayer.h"
+#include "movebatcher.h"
+
+#include <QLocalSocket>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QThreadPool>
+
+const int MAX_LINE = 64;  // longer requests are not ours, the connection is dropped
+const boardState::player USER_MARK    = boardState::X_PLAYER;
+const boardState::player VIRTUAL_MARK = boardState::O_PLAYER;
+
+///
+/// \brief gameServer::gameServer Constructor
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param player Virtual player, shared by all the sessions
+/// \param pool Workers computing the virtual player moves
+///
+gameServer::gameServer(const virtualPlayer *player, QThreadPool *pool) :
+    mPlayer(player), mPool(pool), mBatcher(nullptr), mNextId(1), mMovesServed(0)
+{
+    connect(&mLocalServer, &QLocalServer::newConnection, this, [this]{
+        while(mLocalServer.hasPendingConnections()){
+            addConnection(mLocalServer.nextPendingConnection());
+        }
+    });
+    connect(&mTcpServer, &QTcpServer::newConnection, this, [this]{
+        while(mTcpServer.hasPendingConnections()){
+            addConnection(mTcpServer.nextPendingConnection());
+        }
+    });
+}
+
+///
+/// \brief gameServer::listenLocal Listens on a local socket
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param name Socket name
+///
+/// \return false on error, see errorString()
+///
+bool gameServer::listenLocal(const QString &name)
+{
+    // A crashed server leaves its socket behind
+    QLocalServer::removeServer(name);
+    mLocalServer.setMaxPendingConnections(1024);
+
+    if(!mLocalServer.listen(name)){
+        mError = mLocalServer.errorString();
+        return false;
+    }
+    return true;
+}
+
+///
+/// \brief gameServer::listenTcp Listens on a TCP port of localhost
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param port Port number
+///
+/// \return false on error, see errorString()
+///
+bool gameServer::listenTcp(const quint16 port)
+{
+    mTcpServer.setMaxPendingConnections(1024);
+
+    if(!mTcpServer.listen(QHostAddress::LocalHost, port)){
+        mError = mTcpServer.errorString();
+        return false;
+    }
+    return true;
+}
+
+///
+/// \brief gameServer::addConnection Starts serving a client
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param socket Client connection, owned by its server
+///
+void gameServer::addConnection(QIODevice *socket)
+{
+    connect(socket, &QIODevice::readyRead, this, [this, socket]{
+        while(socket->canReadLine()){
+            handleRequest(socket, socket->readLine().trimmed());
+        }
+        if(socket->bytesAvailable()>MAX_LINE){
+            dropConnection(socket);
+        }
+    });
+
+    QLocalSocket *local = qobject_cast<QLocalSocket*>(socket);
+    if(local!=nullptr){
+        connect(local, &QLocalSocket::disconnected, this, [this, socket]{ dropConnection(socket); });
+    }
+    QTcpSocket *tcp = qobject_cast<QTcpSocket*>(socket);
+    if(tcp!=nullptr){
+        tcp->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        connect(tcp, &QTcpSocket::disconnected, this, [this, socket]{ dropConnection(socket); });
+    }
+}
+
+///
+/// \brief gameServer::dropConnection Ends the sessions of a client and closes it
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param socket Client connection
+///
+void gameServer::dropConnection(QIODevice *socket)
+{
+    for(auto it=mSessions.begin(); it!=mSessions.end();){
+        if(it->owner==socket){
+            it = mSessions.erase(it);
+        }
+        else{
+            ++it;
+        }
+    }
+
+    mPendingGames.remove(socket);
+    socket->disconnect(this);
+    socket->close();
+    socket->deleteLater();
+}
+
+///
+/// \brief gameServer::handleRequest Runs one request line
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param socket Client connection
+/// \param line Request, without the line end
+///
+void gameServer::handleRequest(QIODevice *socket, const QByteArray &line)
+{
+    const QList<QByteArray> args = line.split(' ');
+
+    if(args.first()=="NEW"){
+        newGame(socket, args);
+    }
+    else if(args.first()=="MOVE"){
+        userMove(socket, args);
+    }
+    else if(args.first()=="END"){
+        endGame(socket, args);
+    }
+    else if(!line.isEmpty()){
+        sendError(socket, "-", "unknown_request");
+    }
+}
+
+///
+/// \brief gameServer::newGame NEW [X|O], starts a session
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param socket Client connection
+/// \param args Request words
+///
+void gameServer::newGame(QIODevice *socket, const QList<QByteArray> &args)
+{
+    const bool virtualFirst = (args.size()>1 && args[1]=="O");
+    const quint32 id = mNextId++;
+
+    session &s = mSessions[id];
+    s.board = boardState();
+    s.owner = socket;
+    s.busy = false;
+
+    // The opening move takes the same way as the replies, GAME goes out once it is played
+    mPendingGames[socket].enqueue(id);
+    if(virtualFirst){
+        requestMove(id, socket, true);
+    }
+    sendGames(socket);
+}
+
+///
+/// \brief gameServer::sendGames Sends the GAME responses of a client that are ready, in
+/// request order; a NEW O still waiting for its opening move holds back the ones after it.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param socket Client connection
+///
+void gameServer::sendGames(QIODevice *socket)
+{
+    QQueue<quint32> &pending = mPendingGames[socket];
+    while(!pending.isEmpty()){
+        auto it = mSessions.find(pending.head());
+        if(it!=mSessions.end()){
+            if(it->busy){
+                break;
+            }
+            socket->write("GAME " + boardText(it.key(), it->board) + "\n");
+        }
+        pending.dequeue();
+    }
+}
+
+///
+/// \brief gameServer::userMove MOVE <id> <cell>, plays the user move and sends the
+/// virtual player reply once a worker has it.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param socket Client connection
+/// \param args Request words
+///
+void gameServer::userMove(QIODevice *socket, const QList<QByteArray> &args)
+{
+    if(args.size()<3){
+        sendError(socket, "-", "bad_request");
+        return;
+    }
+
+    bool ok = false;
+    const quint32 id = args[1].toUInt(&ok);
+    auto it = mSessions.find(id);
+    if(!ok || it==mSessions.end() || it->owner!=socket){
+        sendError(socket, args[1], "unknown_game");
+        return;
+    }
+
+    session &s = *it;
+    const int cell = args[2].toInt(&ok);
+    if(s.busy){
+        sendError(socket, args[1], "busy");
+        return;
+    }
+    if(!ok || !s.board.isLegal(cell) ||
+       boardState::popCount(s.board.mask(USER_MARK))>boardState::popCount(s.board.mask(VIRTUAL_MARK))){
+        sendError(socket, args[1], "illegal_move");
+        return;
+    }
+
+    s.board.play(cell, USER_MARK);
+    if(s.board.isOver()){
+        socket->write("BOARD " + boardText(id, s.board) + " -\n");
+        return;
+    }
+
+    requestMove(id, socket, false);
+}
+
+///
+/// \brief gameServer::requestMove Computes the next virtual player move of a session on
+/// the pool or the batcher, it is played back on the event loop by virtualMove.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param id Session id
+/// \param socket Client connection
+/// \param opening true for the opening move of NEW O, answered with GAME
+///
+void gameServer::requestMove(const quint32 id, QIODevice *socket, const bool opening)
+{
+    session &s = mSessions[id];
+    s.busy = true;
+    const boardState board = s.board;
+    QPointer<QIODevice> client(socket);
+    auto played = [this, id, client, opening](const int move){
+        QMetaObject::invokeMethod(this, [this, id, move, client, opening]{ virtualMove(id, move, client, opening); },
+                                  Qt::QueuedConnection);
+    };
+
+    if(mBatcher!=nullptr){
+        mBatcher->submit(board, played);
+        return;
+    }
+
+    const virtualPlayer *player = mPlayer;
+    mPool->start([player, board, played]{ played(player->chooseMove(board)); });
+}
+
+///
+/// \brief gameServer::virtualMove Plays a virtual player move and sends it
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param id Session id
+/// \param move Reply
+/// \param client Client connection, null once it went away
+/// \param opening true for the opening move of NEW O
+///
+void gameServer::virtualMove(const quint32 id, const int move, const QPointer<QIODevice> &client, const bool opening)
+{
+    auto it = mSessions.find(id);
+    if(it==mSessions.end()){
+        // the client went away meanwhile
+        return;
+    }
+
+    it->busy = false;
+    it->board.play(move, VIRTUAL_MARK);
+    mMovesServed++;
+    if(client.isNull()){
+        return;
+    }
+    if(opening){
+        sendGames(client.data());
+    }
+    else{
+        client->write("BOARD " + boardText(id, it->board) + " " + QByteArray::number(move) + "\n");
+    }
+}
+
+///
+/// \brief gameServer::endGame END <id>, frees a session
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param socket Client connection
+/// \param args Request words
+///
+void gameServer::endGame(QIODevice *socket, const QList<QByteArray> &args)
+{
+    bool ok = false;
+    const quint32 id = (args.size()>1) ? args[1].toUInt(&ok) : 0;
+    auto it = mSessions.find(id);
+    if(!ok || it==mSessions.end() || it->owner!=socket){
+        sendError(socket, (args.size()>1) ? args[1] : QByteArray("-"), "unknown_game");
+        return;
+    }
+
+    // A move on its way finds no session and is dropped
+    mSessions.erase(it);
+    socket->write("OK " + QByteArray::number(id) + "\n");
+}
+
+///
+/// \brief gameServer::boardText Board part of the responses
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param id Session id
+/// \param board Board
+///
+/// \return "<id> <cells> <status>"
+///
+QByteArray gameServer::boardText(const quint32 id, const boardState &board)
+{
+    char cells[boardState::TOTAL_CELLS];
+    for(int i=0; i<boardState::TOTAL_CELLS; i++){
+        const int c = board.cell(i);
+        cells[i] = (c==USER_MARK) ? 'X' : (c==VIRTUAL_MARK) ? 'O' : '.';
+    }
+
+    const char *status = "in_progress";
+    switch(board.gameStatus()){
+        case boardState::X_WON:
+            status = "x_won";
+            break;
+        case boardState::O_WON:
+            status = "o_won";
+            break;
+        case boardState::DRAW:
+            status = "draw";
+            break;
+        case boardState::IN_PROGRESS:
+            break;
+    };
+
+    return QByteArray::number(id) + " " + QByteArray(cells, boardState::TOTAL_CELLS) + " " + status;
+}
+
+///
+/// \brief gameServer::sendError Sends an error response
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param socket Client connection
+/// \param id Session id as received, "-" if none
+/// \param reason Error code
+///
+void gameServer::sendError(QIODevice *socket, const QByteArray &id, const QByteArray &reason)
+{
+    socket->write("ERROR " + id + " " + reason + "\n");
+}
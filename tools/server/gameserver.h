@@ -0,0 +1,93 @@
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include "boardstate.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QQueue>
+#include <QLocalServer>
+#include <QTcpServer>
+
+class virtualPlayer;
+class moveBatcher;
+class QThreadPool;
+
+///
+/// \brief The gameServer class
+///
+/// Hosts any number of independent 3 x 3 games, for clients connected
+/// through a local socket or TCP on localhost. The user plays X, the
+/// virtual player O. Requests and responses are text lines:
+///
+///     NEW [X|O]            -> GAME <id> <cells> <status>
+///     MOVE <id> <cell>     -> BOARD <id> <cells> <status> <reply>
+///     END <id>             -> OK <id>
+///     anything wrong       -> ERROR <id|-> <reason>
+///
+/// NEW starts a game, X (the user) moves first unless O is asked for.
+/// MOVE plays the user move and answers with the virtual player reply,
+/// or '-' when the game ended first. Cells are 9 characters, '.', 'X'
+/// or 'O', row-major; status is in_progress, x_won, o_won or draw.
+/// A session takes one request at a time. GAME responses keep the order
+/// of the NEW requests of their connection; for NEW O it waits for the
+/// opening move, computed like the MOVE replies.
+///
+/// Sessions are a few bytes each, and die with the connection that
+/// created them. The virtual player moves run on a shared worker pool;
+/// sessions and sockets are only touched by the thread running the
+/// event loop. With a batcher set, the moves of all the sessions are
+/// gathered in micro-batches instead, one network pass per batch.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class gameServer : public QObject
+{
+public:
+    gameServer(const virtualPlayer *player, QThreadPool *pool);
+
+    bool listenLocal(const QString &name);
+    bool listenTcp(const quint16 port);
+    QString errorString() const { return mError; };
+
+    // nullptr (default) moves every session on its own on the pool
+    void setBatcher(moveBatcher *batcher) { mBatcher = batcher; };
+
+    int sessionCount() const { return mSessions.size(); };
+    quint64 movesServed() const { return mMovesServed; };
+
+protected:
+    struct session {
+        boardState board;
+        QIODevice *owner;  // connection that created it
+        bool busy;         // a virtual move is on its way
+    };
+
+    const virtualPlayer *mPlayer;
+    QThreadPool *mPool;
+    moveBatcher *mBatcher;
+    QLocalServer mLocalServer;
+    QTcpServer mTcpServer;
+    QHash<quint32, session> mSessions;
+    QHash<QIODevice*, QQueue<quint32>> mPendingGames;  // sessions waiting for their GAME response
+    quint32 mNextId;
+    quint64 mMovesServed;
+    QString mError;
+
+    void addConnection(QIODevice *socket);
+    void dropConnection(QIODevice *socket);
+    void handleRequest(QIODevice *socket, const QByteArray &line);
+    void newGame(QIODevice *socket, const QList<QByteArray> &args);
+    void userMove(QIODevice *socket, const QList<QByteArray> &args);
+    void endGame(QIODevice *socket, const QList<QByteArray> &args);
+    void sendGames(QIODevice *socket);
+    void requestMove(const quint32 id, QIODevice *socket, const bool opening);
+    void virtualMove(const quint32 id, const int move, const QPointer<QIODevice> &client, const bool opening);
+
+    static QByteArray boardText(const quint32 id, const boardState &board);
+    static void sendError(QIODevice *socket, const QByteArray &id, const QByteArray &reason);
+};
+
+#endif // GAMESERVER_H
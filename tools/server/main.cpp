@@ -0,0 +1,111 @@
+#include "gameserver.h"
+#include "virtualplayer.h"
+#include "movebatcher.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QScopedPointer>
+#include <QThreadPool>
+#include <QTimer>
+#include <QTextStream>
+
+const int STATS_INTERVAL = 10000; // ms
+
+///
+/// \brief main Headless game server, many independent games in one process
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param argc parameter counter
+/// \param argv parameters
+/// \return Error Code
+///
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("TicTacToe game server, see tools/server/gameserver.h for the protocol."));
+    parser.addHelpOption();
+    QCommandLineOption socketOption(QStringLiteral("socket"), QStringLiteral("Local socket name."),
+                                    QStringLiteral("name"), QStringLiteral("tictactoe"));
+    QCommandLineOption portOption(QStringLiteral("port"), QStringLiteral("Listen on this TCP port of localhost instead."),
+                                  QStringLiteral("port"));
+    QCommandLineOption engineOption(QStringLiteral("engine"),
+                                    QStringLiteral("Virtual player engine: network, quantized, table or negamax."),
+                                    QStringLiteral("name"), QStringLiteral("network"));
+    QCommandLineOption modelOption(QStringLiteral("model"), QStringLiteral("Binary network model."),
+                                   QStringLiteral("file"));
+    QCommandLineOption threadsOption(QStringLiteral("threads"), QStringLiteral("Inference workers."),
+                                     QStringLiteral("n"), QString::number(QThread::idealThreadCount()));
+    QCommandLineOption batchOption(QStringLiteral("batch"),
+                                   QStringLiteral("Network moves of many games in one pass, at most this many, 1 for none."),
+                                   QStringLiteral("n"), QStringLiteral("1"));
+    QCommandLineOption batchWaitOption(QStringLiteral("batch-wait"),
+                                       QStringLiteral("Longest wait of a move for its batch to fill up, in microseconds."),
+                                       QStringLiteral("us"), QStringLiteral("500"));
+    parser.addOption(socketOption);
+    parser.addOption(portOption);
+    parser.addOption(engineOption);
+    parser.addOption(modelOption);
+    parser.addOption(threadsOption);
+    parser.addOption(batchOption);
+    parser.addOption(batchWaitOption);
+    parser.process(app);
+
+    virtualPlayer player;
+    player.setEngine(virtualPlayer::engineFromName(parser.value(engineOption)));
+    if(!virtualPlayer::isBulkEngine(player.engine())){
+        qWarning() << parser.value(engineOption) << "is too slow for bulk play, not served";
+        return 1;
+    }
+    if(parser.isSet(modelOption) && !player.loadModel(parser.value(modelOption))){
+        return 1;
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, parser.value(threadsOption).toInt()));
+
+    gameServer server(&player, &pool);
+    const bool listening = parser.isSet(portOption) ?
+                           server.listenTcp(static_cast<quint16>(parser.value(portOption).toUInt())) :
+                           server.listenLocal(parser.value(socketOption));
+    if(!listening){
+        qWarning() << "cannot listen:" << server.errorString();
+        return 1;
+    }
+
+    // Posts back to the server, it goes before it. Only the networks score a batch in
+    // one pass, the other engines keep moving on the pool
+    QScopedPointer<moveBatcher> batcher;
+    if(parser.value(batchOption).toInt()>1 && !virtualPlayer::isNetworkEngine(player.engine())){
+        qWarning() << parser.value(engineOption) << "does not batch, --batch ignored";
+    }
+    else if(parser.value(batchOption).toInt()>1){
+        batcher.reset(new moveBatcher(&player, parser.value(batchOption).toInt(), parser.value(batchWaitOption).toInt()));
+        server.setBatcher(batcher.data());
+    }
+
+    QTextStream out(stdout);
+    out << "serving on " << (parser.isSet(portOption) ? QStringLiteral("localhost:") + parser.value(portOption)
+                                                      : parser.value(socketOption))
+        << " with " << pool.maxThreadCount() << " workers" << Qt::endl;
+
+    QTimer stats;
+    QObject::connect(&stats, &QTimer::timeout, [&]{
+        out << server.sessionCount() << " sessions, " << server.movesServed() << " moves served" << Qt::endl;
+        if(!batcher.isNull()){
+            const moveBatcher::batchStats b = batcher->stats();
+            out << "batches: " << b.batches << ", " << QString::number(b.meanBatch(), 'f', 1) << " moves each, latency p50 "
+                << QString::number(b.p50Ns/1000.0, 'f', 1) << " us, p99 " << QString::number(b.p99Ns/1000.0, 'f', 1) << " us" << Qt::endl;
+        }
+    });
+    stats.start(STATS_INTERVAL);
+
+    const int retVal = app.exec();
+
+    // The workers post back to the server, they go first
+    pool.waitForDone();
+    return retVal;
+}
@@ -0,0 +1,16 @@
+QT -= gui
+QT += network
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+include(../../core.pri)
+
+SOURCES += \
+        gameserver.cpp \
+        main.cpp
+
+HEADERS += \
+    gameserver.h
+
+TARGET=server
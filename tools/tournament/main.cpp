@@ -0,0 +1,381 @@
+#include "gamerecord.h"
+#include "gamesession.h"
+#include "virtualplayer.h"
+#include "workstealingpool.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+#include <memory>
+#include <vector>
+
+const int CHUNK_GAMES = 1024;  // games per pool task
+
+// Result counters of a pairing. A forfeit is also a loss of the side that made it.
+enum resultSlot {ROW_WINS, DRAWS, ROW_LOSSES, ROW_FORFEITS, COLUMN_FORFEITS, RESULT_SLOTS};
+
+///
+/// \brief The tournamentPlayer class, a participant able to play both sides
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class tournamentPlayer
+{
+public:
+    virtual ~tournamentPlayer() {};
+    virtual int move(const boardState &board, const boardState::player side) = 0;
+};
+
+///
+/// \brief The enginePlayer class, one of the virtual player engines. The engines play O,
+/// boards are shown to them with the marks swapped when they play X.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class enginePlayer : public tournamentPlayer
+{
+public:
+    explicit enginePlayer(const virtualPlayer::engineType engine) { mPlayer.setEngine(engine); };
+
+    int move(const boardState &board, const boardState::player side) override {
+        if(side==boardState::O_PLAYER){
+            return mPlayer.chooseMove(board);
+        }
+        return mPlayer.chooseMove(boardState(board.mask(boardState::X_PLAYER), board.mask(boardState::O_PLAYER)));
+    };
+
+    bool setModel(const networkModel &model) { return mPlayer.setModel(model); };
+    void setCacheSize(const int entries) { mPlayer.setCacheSize(entries); };
+    inferenceCache::cacheStats cacheStats() const { return mPlayer.cacheStats(); };
+
+protected:
+    virtualPlayer mPlayer;
+};
+
+///
+/// \brief The randomPlayer class, plays any legal move
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class randomPlayer : public tournamentPlayer
+{
+public:
+    explicit randomPlayer(const quint64 seed) : mState(seed | 1) {};
+
+    int move(const boardState &board, const boardState::player) override {
+        uint16_t empty = board.emptyCells();
+        int pick = static_cast<int>(next() % static_cast<quint64>(boardState::popCount(empty)));
+        for(; pick>0; pick--){
+            empty &= static_cast<uint16_t>(empty - 1);
+        }
+        for(int i=0; i<boardState::TOTAL_CELLS; i++){
+            if(empty & (1u << i)){
+                return i;
+            }
+        }
+        return -1;
+    };
+
+protected:
+    quint64 mState;
+
+    quint64 next() {
+        mState ^= mState << 13;
+        mState ^= mState >> 7;
+        mState ^= mState << 17;
+        return mState;
+    };
+};
+
+///
+/// \brief makePlayer Creates a participant from its name
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param name random, or an engine name
+/// \param seed Random player seed
+///
+/// \return The participant
+///
+static std::unique_ptr<tournamentPlayer> makePlayer(const QString &name, const quint64 seed)
+{
+    if(name==QStringLiteral("random")){
+        return std::unique_ptr<tournamentPlayer>(new randomPlayer(seed));
+    }
+    return std::unique_ptr<tournamentPlayer>(new enginePlayer(virtualPlayer::engineFromName(name)));
+}
+
+///
+/// \brief The workerContext struct, participants and results of one thread
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+struct workerContext {
+    std::vector<std::unique_ptr<tournamentPlayer>> players;
+    std::vector<qint64> results;  // per pairing: RESULT_SLOTS counters
+    qint64 moves = 0;
+    gameSession session;
+    gameRecordWriter *recorder = nullptr;
+};
+
+///
+/// \brief playChunk Plays a run of games of one pairing, the first move alternates.
+/// An illegal move forfeits the game, forfeited games are not recorded.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param context Thread context
+/// \param xPlayer Participant playing X
+/// \param oPlayer Participant playing O
+/// \param pairing Result slot
+/// \param firstGame Number of the first game, its parity picks who starts
+/// \param games Games to play
+///
+static void playChunk(workerContext &context, const int xPlayer, const int oPlayer, const int pairing,
+                      const qint64 firstGame, const int games)
+{
+    gameSession &session = context.session;
+
+    for(qint64 g=firstGame; g<firstGame + games; g++){
+        session.newGame((g%2==0) ? boardState::X_PLAYER : boardState::O_PLAYER);
+
+        boardState board;
+        bool forfeit = false;
+        while(!session.isOver()){
+            const boardState::player side = session.toMove();
+            const int index = (side==boardState::X_PLAYER) ? context.players[xPlayer]->move(board, side)
+                                                            : context.players[oPlayer]->move(board, side);
+            if(!session.play(index)){
+                forfeit = true;
+                break;
+            }
+            board.play(index, side);
+            context.moves++;
+        }
+
+        qint64 *results = context.results.data() + pairing*RESULT_SLOTS;
+        if(forfeit){
+            // The side to move is the one that played the illegal move
+            if(session.toMove()==boardState::X_PLAYER){
+                results[ROW_LOSSES]++;
+                results[ROW_FORFEITS]++;
+            }
+            else{
+                results[ROW_WINS]++;
+                results[COLUMN_FORFEITS]++;
+            }
+            continue;
+        }
+
+        if(context.recorder!=nullptr){
+            context.recorder->append(gameRecord::fromSession(session));
+        }
+
+        switch(session.status()){
+            case boardState::X_WON:
+                results[ROW_WINS]++;
+                break;
+            case boardState::DRAW:
+                results[DRAWS]++;
+                break;
+            case boardState::O_WON:
+            case boardState::IN_PROGRESS:
+                results[ROW_LOSSES]++;
+                break;
+        };
+    }
+}
+
+///
+/// \brief main Plays every participant against every other one, itself included,
+/// on all the cores and without a display.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param argc parameter counter
+/// \param argv parameters
+/// \return Error Code
+///
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Headless engine vs engine tournament."));
+    parser.addHelpOption();
+    QCommandLineOption playersOption(QStringLiteral("players"),
+                                     QStringLiteral("Comma separated participants: random, network, quantized, table, negamax."),
+                                     QStringLiteral("names"), QStringLiteral("network,quantized,random,table,negamax"));
+    QCommandLineOption gamesOption(QStringLiteral("games"), QStringLiteral("Games per pairing."),
+                                   QStringLiteral("n"), QStringLiteral("100000"));
+    QCommandLineOption modelOption(QStringLiteral("model"), QStringLiteral("Binary network model for the network players."),
+                                   QStringLiteral("file"));
+    QCommandLineOption threadsOption(QStringLiteral("threads"), QStringLiteral("Worker threads."),
+                                     QStringLiteral("n"), QString::number(QThread::idealThreadCount()));
+    QCommandLineOption cacheOption(QStringLiteral("cache-size"), QStringLiteral("Network result cache entries per player, 0 for none."),
+                                   QStringLiteral("n"), QStringLiteral("0"));
+    QCommandLineOption seedOption(QStringLiteral("seed"), QStringLiteral("Random player seed."),
+                                  QStringLiteral("n"), QStringLiteral("1"));
+    QCommandLineOption recordOption(QStringLiteral("record"), QStringLiteral("Append every game to this archive."),
+                                    QStringLiteral("file"));
+    parser.addOption(playersOption);
+    parser.addOption(gamesOption);
+    parser.addOption(modelOption);
+    parser.addOption(threadsOption);
+    parser.addOption(cacheOption);
+    parser.addOption(seedOption);
+    parser.addOption(recordOption);
+    parser.process(app);
+
+    QStringList names;
+    for(const QString &name : parser.value(playersOption).split(QLatin1Char(','), Qt::SkipEmptyParts)){
+        if(name.trimmed()!=QStringLiteral("random") &&
+           !virtualPlayer::isBulkEngine(virtualPlayer::engineFromName(name.trimmed()))){
+            qWarning() << name << "is too slow for bulk play, left out";
+            continue;
+        }
+        names.append(name.trimmed());
+    }
+    if(names.isEmpty()){
+        parser.showHelp(1);
+    }
+
+    networkModel model;
+    if(parser.isSet(modelOption) && !model.loadBinary(parser.value(modelOption))){
+        return 1;
+    }
+
+    const qint64 games = qMax<qint64>(1, parser.value(gamesOption).toLongLong());
+    const int pairings = names.size()*names.size();
+    const quint64 seed = parser.value(seedOption).toULongLong();
+
+    workStealingPool pool(qMax(1, parser.value(threadsOption).toInt()));
+
+    // One context per worker, plus one for this thread, which helps while waiting
+    std::vector<workerContext> contexts(pool.threadCount() + 1);
+    for(int c=0; c<static_cast<int>(contexts.size()); c++){
+        for(const QString &name : names){
+            contexts[c].players.push_back(makePlayer(name, seed + c));
+        }
+        contexts[c].results.assign(pairings*RESULT_SLOTS, 0);
+    }
+    const int cacheSize = qMax(0, parser.value(cacheOption).toInt());
+    for(workerContext &context : contexts){
+        for(std::unique_ptr<tournamentPlayer> &player : context.players){
+            enginePlayer *engine = dynamic_cast<enginePlayer*>(player.get());
+            if(engine==nullptr){
+                continue;
+            }
+            if(!model.isEmpty() && !engine->setModel(model)){
+                return 1;
+            }
+            engine->setCacheSize(cacheSize);
+        }
+    }
+
+    gameRecordWriter recorder;
+    if(parser.isSet(recordOption)){
+        if(!recorder.open(parser.value(recordOption))){
+            qWarning() << recorder.errorString();
+            return 1;
+        }
+        for(workerContext &context : contexts){
+            context.recorder = &recorder;
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for(int x=0; x<names.size(); x++){
+        for(int o=0; o<names.size(); o++){
+            const int pairing = x*names.size() + o;
+            for(qint64 first=0; first<games; first+=CHUNK_GAMES){
+                const int count = static_cast<int>(qMin<qint64>(CHUNK_GAMES, games - first));
+                pool.submit([&pool, &contexts, x, o, pairing, first, count]{
+                    const int worker = pool.currentWorker();
+                    workerContext &context = contexts[(worker<0) ? pool.threadCount() : worker];
+                    playChunk(context, x, o, pairing, first, count);
+                });
+            }
+        }
+    }
+    pool.wait();
+    recorder.flush();
+
+    const qint64 elapsedNs = qMax<qint64>(1, timer.nsecsElapsed());
+
+    std::vector<qint64> results(pairings*RESULT_SLOTS, 0);
+    qint64 moves = 0;
+    inferenceCache::cacheStats cache;
+    for(const workerContext &context : contexts){
+        for(int i=0; i<pairings*RESULT_SLOTS; i++){
+            results[i] += context.results[i];
+        }
+        moves += context.moves;
+        for(const std::unique_ptr<tournamentPlayer> &player : context.players){
+            const enginePlayer *engine = dynamic_cast<const enginePlayer*>(player.get());
+            if(engine!=nullptr){
+                cache.hits += engine->cacheStats().hits;
+                cache.misses += engine->cacheStats().misses;
+            }
+        }
+    }
+
+    QTextStream out(stdout);
+    out << "Row plays X, column plays O, the first move alternates. Row win / draw / loss %" << Qt::endl;
+    out << QString(12, QLatin1Char(' '));
+    for(const QString &name : names){
+        out << name.leftJustified(21).left(21);
+    }
+    out << Qt::endl;
+
+    for(int x=0; x<names.size(); x++){
+        out << names[x].leftJustified(12).left(12);
+        for(int o=0; o<names.size(); o++){
+            const qint64 *r = results.data() + (x*names.size() + o)*RESULT_SLOTS;
+            const double total = static_cast<double>(qMax<qint64>(1, r[ROW_WINS] + r[DRAWS] + r[ROW_LOSSES]));
+            out << QStringLiteral("%1/%2/%3").arg(100.0*r[ROW_WINS]/total, 5, 'f', 1)
+                                              .arg(100.0*r[DRAWS]/total, 5, 'f', 1)
+                                              .arg(100.0*r[ROW_LOSSES]/total, 5, 'f', 1).leftJustified(21);
+        }
+        out << Qt::endl;
+    }
+
+    // Illegal moves, apart so a broken engine does not pass for a weak one
+    bool forfeitsHeader = false;
+    for(int x=0; x<names.size(); x++){
+        for(int o=0; o<names.size(); o++){
+            const qint64 *r = results.data() + (x*names.size() + o)*RESULT_SLOTS;
+            if(r[ROW_FORFEITS]==0 && r[COLUMN_FORFEITS]==0){
+                continue;
+            }
+            if(!forfeitsHeader){
+                out << Qt::endl << "Forfeits, games lost by an illegal move (counted as losses above):" << Qt::endl;
+                forfeitsHeader = true;
+            }
+            out << names[x] << " (X) vs " << names[o] << " (O): " << r[ROW_FORFEITS] << " by X, "
+                << r[COLUMN_FORFEITS] << " by O" << Qt::endl;
+        }
+    }
+
+    const qint64 totalGames = games*pairings;
+    out << Qt::endl << totalGames << " games, " << moves << " moves in "
+        << QString::number(elapsedNs/1e9, 'f', 2) << " s on " << pool.threadCount() << " threads: "
+        << QString::number(totalGames*1e9/elapsedNs, 'f', 0) << " games/s" << Qt::endl;
+    if(cacheSize>0){
+        out << "network cache: " << cache.hits << " hits, " << cache.misses << " misses ("
+            << QString::number(100.0*cache.hitRate(), 'f', 1) << "%)" << Qt::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "networktrainer.h"
+#include "virtualplayer.h"
+#include "perfectplay.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QDir>
+#include <QTextStream>
+
+///
+/// \brief main Trains the move network on perfect play positions and writes it
+/// as a model the game can load.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param argc parameter counter
+/// \param argv parameters
+/// \return Error Code
+///
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    networkTrainer::settings config;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Move network trainer, labels from the perfect play table."));
+    parser.addHelpOption();
+    QCommandLineOption outputOption(QStringList() << QStringLiteral("o") << QStringLiteral("output"),
+                                    QStringLiteral("Binary model file to write."),
+                                    QStringLiteral("file"), QStringLiteral("tictactoe.model"));
+    QCommandLineOption csvOption(QStringLiteral("csv"),
+                                 QStringLiteral("Also write t1.csv and t2.csv to this directory."),
+                                 QStringLiteral("dir"));
+    QCommandLineOption hiddenOption(QStringLiteral("hidden"), QStringLiteral("Hidden neurons."),
+                                    QStringLiteral("n"), QString::number(config.hidden));
+    QCommandLineOption epochsOption(QStringLiteral("epochs"), QStringLiteral("Passes over the training set."),
+                                    QStringLiteral("n"), QString::number(config.epochs));
+    QCommandLineOption batchOption(QStringLiteral("batch"), QStringLiteral("Minibatch size."),
+                                   QStringLiteral("n"), QString::number(config.batchSize));
+    QCommandLineOption rateOption(QStringLiteral("rate"), QStringLiteral("Adam learning rate."),
+                                  QStringLiteral("r"), QString::number(config.learningRate));
+    QCommandLineOption seedOption(QStringLiteral("seed"), QStringLiteral("Random seed."),
+                                  QStringLiteral("n"), QString::number(config.seed));
+    QCommandLineOption threadsOption(QStringLiteral("threads"), QStringLiteral("Training threads."),
+                                     QStringLiteral("n"), QString::number(config.threads));
+    parser.addOption(outputOption);
+    parser.addOption(csvOption);
+    parser.addOption(hiddenOption);
+    parser.addOption(epochsOption);
+    parser.addOption(batchOption);
+    parser.addOption(rateOption);
+    parser.addOption(seedOption);
+    parser.addOption(threadsOption);
+    parser.process(app);
+
+    config.hidden = qMax(1, parser.value(hiddenOption).toInt());
+    config.epochs = qMax(1, parser.value(epochsOption).toInt());
+    config.batchSize = qMax(1, parser.value(batchOption).toInt());
+    config.learningRate = parser.value(rateOption).toDouble();
+    config.seed = parser.value(seedOption).toUInt();
+    config.threads = qMax(1, parser.value(threadsOption).toInt());
+
+    QTextStream out(stdout);
+
+    networkTrainer trainer(config);
+    trainer.addSolverPositions();
+    out << trainer.sampleCount() << " positions, " << config.threads << " threads" << Qt::endl;
+
+    QElapsedTimer timer;
+    timer.start();
+    trainer.train([&](const int epoch, const double loss){
+        if(epoch==1 || epoch%100==0 || epoch==config.epochs){
+            out << "epoch " << epoch << "  loss " << QString::number(loss, 'f', 4) << Qt::endl;
+        }
+        return true;
+    });
+    out << "trained in " << QString::number(timer.elapsed()/1000.0, 'f', 2) << " s" << Qt::endl;
+
+    const networkModel model = trainer.model();
+
+    virtualPlayer player;
+    if(!player.setModel(model)){
+        return 1;
+    }
+    const perfectPlay::accuracyReport report = perfectPlay::measureEngine([&](const boardState &board){
+        return player.networkMove(board);
+    });
+    out << "optimal moves: " << report.optimalMoves << " of " << report.positions
+        << " (" << QString::number(100.0*report.optimalMoves/qMax(1, report.positions), 'f', 2) << "%)" << Qt::endl;
+
+    if(!model.saveBinary(parser.value(outputOption))){
+        return 1;
+    }
+    out << "model written to " << parser.value(outputOption) << Qt::endl;
+
+    if(parser.isSet(csvOption)){
+        const QDir dir(parser.value(csvOption));
+        if(!model.saveCsv(QStringList() << dir.filePath(QStringLiteral("t1.csv")) << dir.filePath(QStringLiteral("t2.csv")))){
+            return 1;
+        }
+        out << "theta written to " << dir.filePath(QStringLiteral("t1.csv")) << " and t2.csv" << Qt::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,347 @@
+#include "networktrainer.h"
+#include "perfectplay.h"
+
+#include <QtConcurrent>
+#include <QtMath>
+
+#include <algorithm>
+#include <random>
+
+const double BIAS_VALUE    = 1.00;
+const double ADAM_BETA1    = 0.9;
+const double ADAM_BETA2    = 0.999;
+const double ADAM_EPSILON  = 1e-8;
+const double LOG_EPSILON   = 1e-12;  // keeps log() finite on saturated outputs
+const int SHARD_SIZE       = 32;     // positions per shard, the gradient sums do not depend on the threads
+
+///
+/// \brief multiplyABt C = A * B', A is M x K, B is N x K, all row-major.
+/// Every C value is a dot product of two contiguous rows.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+static void multiplyABt(const double *a, const int lda, const double *b, const int ldb,
+                        double *c, const int ldc, const int m, const int n, const int k)
+{
+    for(int i=0; i<m; i++){
+        const double *ai = a + i*lda;
+        for(int j=0; j<n; j++){
+            const double *bj = b + j*ldb;
+            double sum = 0.00;
+            for(int p=0; p<k; p++){
+                sum += ai[p]*bj[p];
+            }
+            c[i*ldc + j] = sum;
+        }
+    }
+}
+
+///
+/// \brief multiplyAB C = A * B, A is M x K, B is K x N, all row-major.
+/// The inner loop runs along contiguous rows of B and C.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+static void multiplyAB(const double *a, const int lda, const double *b, const int ldb,
+                       double *c, const int ldc, const int m, const int n, const int k)
+{
+    for(int i=0; i<m; i++){
+        double *ci = c + i*ldc;
+        std::fill(ci, ci + n, 0.00);
+        for(int p=0; p<k; p++){
+            const double aip = a[i*lda + p];
+            const double *bp = b + p*ldb;
+            for(int j=0; j<n; j++){
+                ci[j] += aip*bp[j];
+            }
+        }
+    }
+}
+
+///
+/// \brief multiplyAtB C = A' * B, A is K x M, B is K x N, all row-major.
+/// Accumulates one outer product per row of A and B, rows are read once.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+static void multiplyAtB(const double *a, const int lda, const double *b, const int ldb,
+                        double *c, const int ldc, const int m, const int n, const int k)
+{
+    for(int i=0; i<m; i++){
+        std::fill(c + i*ldc, c + i*ldc + n, 0.00);
+    }
+    for(int p=0; p<k; p++){
+        const double *ap = a + p*lda;
+        const double *bp = b + p*ldb;
+        for(int i=0; i<m; i++){
+            double *ci = c + i*ldc;
+            for(int j=0; j<n; j++){
+                ci[j] += ap[i]*bp[j];
+            }
+        }
+    }
+}
+
+///
+/// \brief sigmoid Neuron activation
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+static double sigmoid(const double z)
+{
+    return 1/(qExp(-1*z)+1);
+}
+
+///
+/// \brief networkTrainer::networkTrainer Sets up random initial weights
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param config Training settings
+///
+networkTrainer::networkTrainer(const settings &config) : mSettings(config)
+{
+    mSettings.threads = qMax(1, mSettings.threads);
+    mSettings.batchSize = qMax(1, mSettings.batchSize);
+
+    const int hiddenInputs = mSettings.hidden + 1;
+    std::mt19937 random(mSettings.seed);
+    std::uniform_real_distribution<double> range1(-qSqrt(6.0/(INPUTS + mSettings.hidden)), qSqrt(6.0/(INPUTS + mSettings.hidden)));
+    std::uniform_real_distribution<double> range2(-qSqrt(6.0/(hiddenInputs + OUTPUTS)), qSqrt(6.0/(hiddenInputs + OUTPUTS)));
+
+    mTheta1.fill(0.00, mSettings.hidden*INPUTS);
+    mTheta2.fill(0.00, OUTPUTS*hiddenInputs);
+    for(double &w : mTheta1){
+        w = range1(random);
+    }
+    for(double &w : mTheta2){
+        w = range2(random);
+    }
+
+    mMoment1[0].fill(0.00, mTheta1.size());
+    mMoment2[0].fill(0.00, mTheta1.size());
+    mMoment1[1].fill(0.00, mTheta2.size());
+    mMoment2[1].fill(0.00, mTheta2.size());
+}
+
+///
+/// \brief networkTrainer::addSolverPositions Adds every position the virtual player can
+/// face, labelled by the perfect play table.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void networkTrainer::addSolverPositions()
+{
+    perfectPlay::visitPositions([this](const boardState &board){
+        const boardState::player side = boardState::O_PLAYER;
+        const perfectPlay::gameValue best = perfectPlay::positionValue(board, side);
+
+        mInputs.append(BIAS_VALUE);
+        for(int i=0; i<boardState::TOTAL_CELLS; i++){
+            mInputs.append(static_cast<double>(board.cell(i)));
+
+            const bool legal = board.isLegal(i);
+            mTargets.append((legal && perfectPlay::moveValue(board, side, i)==best) ? 1.00 : 0.00);
+            mMasks.append(legal ? 1.00 : 0.00);
+        }
+    });
+}
+
+///
+/// \brief networkTrainer::runShard Forward and back propagation of a part of a minibatch
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param s Shard, its gradients are overwritten
+/// \param inputs Minibatch inputs
+/// \param targets Minibatch targets
+/// \param masks Minibatch loss masks
+///
+void networkTrainer::runShard(shard &s, const double *inputs, const double *targets, const double *masks) const
+{
+    const int hiddenInputs = mSettings.hidden + 1;
+    const double *x = inputs + s.first*INPUTS;
+    const double *t = targets + s.first*OUTPUTS;
+    const double *m = masks + s.first*OUTPUTS;
+
+    // Hidden layer, bias in the first column
+    multiplyABt(x, INPUTS, mTheta1.constData(), INPUTS, s.hidden.data() + 1, hiddenInputs,
+                s.count, mSettings.hidden, INPUTS);
+    for(int i=0; i<s.count; i++){
+        double *h = s.hidden.data() + i*hiddenInputs;
+        h[0] = BIAS_VALUE;
+        for(int j=1; j<hiddenInputs; j++){
+            h[j] = sigmoid(h[j]);
+        }
+    }
+
+    // Output layer, cross entropy error
+    multiplyABt(s.hidden.constData(), hiddenInputs, mTheta2.constData(), hiddenInputs, s.output.data(), OUTPUTS,
+                s.count, OUTPUTS, hiddenInputs);
+    s.loss = 0.00;
+    for(int i=0; i<s.count*OUTPUTS; i++){
+        const double y = sigmoid(s.output[i]);
+        s.delta2[i] = (y - t[i])*m[i];
+        s.loss -= m[i]*(t[i]*qLn(y + LOG_EPSILON) + (1 - t[i])*qLn(1 - y + LOG_EPSILON));
+    }
+
+    // Back to the hidden layer
+    multiplyAtB(s.delta2.constData(), OUTPUTS, s.hidden.constData(), hiddenInputs, s.grad2.data(), hiddenInputs,
+                OUTPUTS, hiddenInputs, s.count);
+    multiplyAB(s.delta2.constData(), OUTPUTS, mTheta2.constData(), hiddenInputs, s.delta1.data(), hiddenInputs,
+               s.count, hiddenInputs, OUTPUTS);
+    for(int i=0; i<s.count; i++){
+        const double *h = s.hidden.constData() + i*hiddenInputs;
+        double *d = s.delta1.data() + i*hiddenInputs;
+        for(int j=1; j<hiddenInputs; j++){
+            d[j] *= h[j]*(1 - h[j]);
+        }
+    }
+
+    // The bias column has no weights behind it
+    multiplyAtB(s.delta1.constData() + 1, hiddenInputs, x, INPUTS, s.grad1.data(), INPUTS,
+                mSettings.hidden, INPUTS, s.count);
+}
+
+///
+/// \brief networkTrainer::adamStep Updates a weight matrix with the Adam rule
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param theta Weights
+/// \param firstMoment Gradient running mean
+/// \param secondMoment Gradient running square mean
+/// \param gradient Minibatch gradient
+/// \param step Update count, from 1
+///
+void networkTrainer::adamStep(QVector<double> &theta, QVector<double> &firstMoment, QVector<double> &secondMoment,
+                              const QVector<double> &gradient, const int step) const
+{
+    const double correction1 = 1 - qPow(ADAM_BETA1, step);
+    const double correction2 = 1 - qPow(ADAM_BETA2, step);
+
+    for(int i=0; i<theta.size(); i++){
+        firstMoment[i] = ADAM_BETA1*firstMoment[i] + (1 - ADAM_BETA1)*gradient[i];
+        secondMoment[i] = ADAM_BETA2*secondMoment[i] + (1 - ADAM_BETA2)*gradient[i]*gradient[i];
+        theta[i] -= mSettings.learningRate*(firstMoment[i]/correction1)/(qSqrt(secondMoment[i]/correction2) + ADAM_EPSILON);
+    }
+}
+
+///
+/// \brief networkTrainer::train Runs the minibatch training
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param progress Called after every epoch with the mean loss per position
+///
+void networkTrainer::train(const std::function<bool(int, double)> &progress)
+{
+    const int samples = sampleCount();
+    if(samples==0){
+        return;
+    }
+
+    const int hiddenInputs = mSettings.hidden + 1;
+    const int batchSize = qMin(mSettings.batchSize, samples);
+    const int shardSize = qMin(SHARD_SIZE, batchSize);
+
+    QVector<shard> shards;
+    for(int first=0; first<batchSize; first+=shardSize){
+        shard s;
+        s.first = first;
+        s.hidden.fill(0.00, shardSize*hiddenInputs);
+        s.output.fill(0.00, shardSize*OUTPUTS);
+        s.delta2.fill(0.00, shardSize*OUTPUTS);
+        s.delta1.fill(0.00, shardSize*hiddenInputs);
+        s.grad1.fill(0.00, mTheta1.size());
+        s.grad2.fill(0.00, mTheta2.size());
+        shards.append(s);
+    }
+
+    // Minibatches are gathered into contiguous buffers
+    QVector<double> batchInputs(batchSize*INPUTS);
+    QVector<double> batchTargets(batchSize*OUTPUTS);
+    QVector<double> batchMasks(batchSize*OUTPUTS);
+    QVector<double> grad1(mTheta1.size());
+    QVector<double> grad2(mTheta2.size());
+
+    QVector<int> order(samples);
+    for(int i=0; i<samples; i++){
+        order[i] = i;
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(mSettings.threads);
+    std::mt19937 random(mSettings.seed + 1);
+    int step = 0;
+
+    for(int epoch=1; epoch<=mSettings.epochs; epoch++){
+        std::shuffle(order.begin(), order.end(), random);
+        double loss = 0.00;
+
+        for(int first=0; first<samples; first+=batchSize){
+            const int count = qMin(batchSize, samples - first);
+            for(int i=0; i<count; i++){
+                const int sample = order[first + i];
+                std::copy_n(mInputs.constData() + sample*INPUTS, INPUTS, batchInputs.data() + i*INPUTS);
+                std::copy_n(mTargets.constData() + sample*OUTPUTS, OUTPUTS, batchTargets.data() + i*OUTPUTS);
+                std::copy_n(mMasks.constData() + sample*OUTPUTS, OUTPUTS, batchMasks.data() + i*OUTPUTS);
+            }
+            for(shard &s : shards){
+                s.count = qBound(0, count - s.first, shardSize);
+            }
+
+            QtConcurrent::blockingMap(&pool, shards, [&](shard &s){
+                if(s.count>0){
+                    runShard(s, batchInputs.constData(), batchTargets.constData(), batchMasks.constData());
+                }
+            });
+
+            std::fill(grad1.begin(), grad1.end(), 0.00);
+            std::fill(grad2.begin(), grad2.end(), 0.00);
+            for(const shard &s : shards){
+                if(s.count==0){
+                    continue;
+                }
+                loss += s.loss;
+                for(int i=0; i<grad1.size(); i++){
+                    grad1[i] += s.grad1[i]/count;
+                }
+                for(int i=0; i<grad2.size(); i++){
+                    grad2[i] += s.grad2[i]/count;
+                }
+            }
+
+            step++;
+            adamStep(mTheta1, mMoment1[0], mMoment2[0], grad1, step);
+            adamStep(mTheta2, mMoment1[1], mMoment2[1], grad2, step);
+        }
+
+        if(progress && !progress(epoch, loss/samples)){
+            break;
+        }
+    }
+}
+
+///
+/// \brief networkTrainer::model Returns the trained weights as a model
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \return The model, ready for virtualPlayer::setModel
+///
+networkModel networkTrainer::model() const
+{
+    return networkModel({layerMatrix(mTheta1.constData(), mSettings.hidden, INPUTS),
+                         layerMatrix(mTheta2.constData(), OUTPUTS, mSettings.hidden + 1)});
+}
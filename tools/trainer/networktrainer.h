@@ -0,0 +1,86 @@
+#ifndef NETWORKTRAINER_H
+#define NETWORKTRAINER_H
+
+#include "networkmodel.h"
+#include "boardstate.h"
+
+#include <QVector>
+#include <QThread>
+
+#include <functional>
+
+///
+/// \brief The networkTrainer class
+///
+/// Trains the move network (bias + 9 cells -> hidden -> 9 moves) on
+/// positions labelled by the perfect play table. Every minibatch is
+/// split in fixed size shards that the threads share; each shard runs
+/// forward and back propagation as row-major matrix products over
+/// contiguous buffers, the shard gradients are summed in shard order
+/// and applied with Adam. A seed gives the same weights with any number
+/// of threads.
+///
+/// Targets are 1 for every optimal move and 0 for the other legal
+/// moves, occupied cells are left out of the loss. The sigmoid outputs
+/// are trained with cross entropy.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class networkTrainer
+{
+public:
+    static const int INPUTS  = boardState::TOTAL_CELLS + 1;
+    static const int OUTPUTS = boardState::TOTAL_CELLS;
+
+    struct settings {
+        int hidden          = 20;
+        int epochs          = 1000;
+        int batchSize       = 256;
+        double learningRate = 0.01;
+        quint32 seed        = 1;
+        int threads         = QThread::idealThreadCount();
+    };
+
+    explicit networkTrainer(const settings &config);
+
+    void addSolverPositions();
+    int sampleCount() const { return mTargets.size()/OUTPUTS; };
+
+    // progress(epoch, loss) is called after every epoch, returning false stops the training
+    void train(const std::function<bool(int, double)> &progress);
+
+    networkModel model() const;
+
+protected:
+    struct shard {
+        int first = 0;
+        int count = 0;
+        double loss = 0.00;
+        QVector<double> hidden;   // count x (hidden + 1), bias first
+        QVector<double> output;   // count x OUTPUTS
+        QVector<double> delta2;   // count x OUTPUTS
+        QVector<double> delta1;   // count x (hidden + 1)
+        QVector<double> grad1;    // hidden x INPUTS
+        QVector<double> grad2;    // OUTPUTS x (hidden + 1)
+    };
+
+    settings mSettings;
+
+    // Training set, one row per position
+    QVector<double> mInputs;
+    QVector<double> mTargets;
+    QVector<double> mMasks;
+
+    // Weights, one row per neuron, bias weight first, and their Adam moments
+    QVector<double> mTheta1;
+    QVector<double> mTheta2;
+    QVector<double> mMoment1[2];
+    QVector<double> mMoment2[2];
+
+    void runShard(shard &s, const double *inputs, const double *targets, const double *masks) const;
+    void adamStep(QVector<double> &theta, QVector<double> &firstMoment, QVector<double> &secondMoment,
+                  const QVector<double> &gradient, const int step) const;
+};
+
+#endif // NETWORKTRAINER_H
@@ -0,0 +1,15 @@
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+include(../../core.pri)
+
+SOURCES += \
+        main.cpp \
+        networktrainer.cpp
+
+HEADERS += \
+    networktrainer.h
+
+TARGET=trainer
@@ -1,10 +1,19 @@
 #include "virtualplayer.h"
+#include "perfectplay.h"
+#include "staticnetwork.h"
 
 #include <QVector>
 #include <QFuture>
 #include <QtConcurrent>
+#include <QThreadPool>
+#include <QPromise>
+#include <QLoggingCategory>
+#include <QRandomGenerator>
 
-const QVector<QVector<double>> t1 = {
+Q_LOGGING_CATEGORY(engineLog, "tictactoe.engine", QtInfoMsg)
+
+// Built-in model, used until a model file is loaded
+constexpr std::array<std::array<double, 10>, 20> t1 = {{
     {0.3676461363889609,0.4967420792112414,-0.7199093911984394,12.39626384399281,-2.3467093863923,-9.244340348553697,-1.665826120969002,10.53368153409246,-3.185849849436278,0.7695327155868154},
     {1.60943698622091,0.3483757033452727,0.8375881361391267,-0.09346829843458695,-6.130819470896965,-6.477573369922222,10.34865719518361,3.842745577956052,1.137859654401337,-0.297301723728818},
     {1.310054645782639,9.473337546365295,-1.181497896473642,-2.729641113513361,-0.2332843892454713,9.215570656392254,-0.5928528119687496,-0.2065840128684702,-1.124433540099315,7.807279861612548},
@@ -25,9 +34,9 @@ const QVector<QVector<double>> t1 = {
     {-6.936452512350847,-9.256089719795515,-0.779494790696269,2.371908148980896,-0.3307061604241175,-6.664634726084676,1.944788986297036,1.477912298699583,1.946560624959969,-14.37528049942883},
     {-2.649610014850653,0.1609904641265589,0.4900746446257418,7.646008114865441,2.54807028935199,10.83445248305008,-0.5022571008775869,-11.32567333481984,3.156334516631695,-0.4471818682623429},
     {-6.043253712071226,0.6736400311791332,-1.010129643230674,4.203442685190288,7.137140819780209,-5.035294881803098,13.789957292627,-1.754969846949859,-1.171329671055746,-1.372766072336167}
-};
+}};
 
-const QVector<QVector<double>> t2 = {
+constexpr std::array<std::array<double, 21>, 9> t2 = {{
     {-10.89731833850047,1.136521510819719,-6.533150507026796,-13.9165360746306,-9.779502423417691,3.899670460653835,-10.8840138854694,-1.858129159291011,-7.240911494725762,0.6688222287098706,20.44949555180841,2.759190874019403,-2.981787610257532,-4.152979316574054,-12.13023348154294,2.635526262568533,1.110119003988524,2.473020991004196,10.69522441247648,-1.770737287416535,-1.042719528091621},
     {-9.781587718993462,-1.292039786949763,3.557756165989034,-8.352948086745377,9.223636563730247,-25.65804382108363,-5.851542023551868,20.60723383386514,5.27517318750215,5.00915720113691,1.658161976998984,6.751245964603005,8.28534673414697,5.195932799462064,-5.415675713734413,-9.731766326124673,-0.8714430449180551,-12.09859070241575,-16.24714778440946,0.4066393504066173,0.04391945077152368},
     {-5.716593840704354,-10.71570674789675,-9.124478857591695,6.364437423569162,-4.511579615346682,17.22144418275474,-9.872046488107848,-4.198594652328976,-1.200907658730842,16.29803331336105,3.376440883676477,-16.21997935899035,-3.270703064503852,-8.228246703339691,-1.728314425069517,-8.476271848062892,9.752000622348243,6.575937500700428,-5.960820505371342,-13.48155898556618,-4.767842828410545},
@@ -37,15 +46,62 @@ const QVector<QVector<double>> t2 = {
     {-8.924508885531617,-16.53704212747777,-1.260687991595596,1.582069050130158,1.740596484138228,10.60096196396815,-0.9167033418575857,-11.17689212538641,-15.16134431137297,-7.534290002622085,-2.496012871728093,-14.84095901362708,-0.3784293556478817,-3.055088595780806,7.731663956340782,0.9633722729676745,-1.819227854036339,-13.45886473049752,-15.11708500182388,19.46387128063598,9.694749284899405},
     {-14.18103781610169,11.30731046843664,4.102367176938695,-2.480585576500243,11.7008619008372,-21.89425975821535,16.78934248807803,-8.982598935828083,-17.14307671505566,-4.616334299263163,-1.825796835941831,-7.729241364889721,-7.668566392727085,-9.753611290766525,10.50613504252647,1.50774602265684,-9.310106438812284,13.28198830121652,-5.780536202866994,-4.387831360610498,4.046920936844312},
     {-7.137275584305341,1.283839187431586,-0.8579525894415634,-15.93420303533233,5.761020797841612,3.655837068403887,-4.098083477937939,-2.694524179040495,-0.2802909740809827,1.498577680903011,-19.19398622534707,3.401175228883323,-13.39687196113894,3.682174698570372,-7.044800681574936,-0.5630039969680811,3.949966873975425,1.206766842687001,9.215194841657837,7.079517566057101,3.960574622900832}
-};
+}};
+
+const double BIAS_VALUE         = 1.00;
+const boardState::player V_USER_MARK = boardState::O_PLAYER;
+const boardState::player USER_MARK   = boardState::X_PLAYER;
+const int    BATCH_TILE         = 64;
+const qint64 PARALLEL_THRESHOLD = 65536; // multiply-adds, below this a thread hop costs more than it saves
+const int    PONDER_SEARCHES    = 3;     // searched replies per user turn, the likeliest user moves
+const int    PONDER_RANK_SHARE  = 4;     // ranking the user moves takes this part of the time budget
 
-const double BIAS_VALUE      = 1.00;
-const int    EMPTY_SPACE     = -1;
-const int    POSITIVE_RESULT = 1;
-const int    V_USER_MARK     = 0;
+// The built-in model again, with its sizes known to the compiler, for single moves
+using builtInNetwork = staticNetwork<boardState::TOTAL_CELLS, 20, boardState::TOTAL_CELLS>;
+static constexpr builtInNetwork BUILT_IN_NETWORK(t1, t2);
 
 QSharedPointer<virtualPlayer> virtualPlayer::mInstance = nullptr;
 
+///
+/// \brief The inferenceWorkspace struct, scratch buffers of the network evaluation.
+/// One per thread, they only grow, so once a thread has made its first move the
+/// next ones do not touch the heap.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+struct inferenceWorkspace {
+    QVector<double> values;
+    QVector<int> cells;
+    QVector<boardState> misses;       // cache misses of a batch, canonical boards
+    QVector<int> missSlots;           // their batch index and symmetry
+    QVector<double> missScores;
+
+    double *reserveValues(const int size) {
+        if(values.size()<size){
+            values.resize(size);
+        }
+        return values.data();
+    };
+
+    int *reserveCells(const int size) {
+        if(cells.size()<size){
+            cells.resize(size);
+        }
+        return cells.data();
+    };
+
+    void reserveMisses(const int size) {
+        if(misses.size()<size){
+            misses.resize(size);
+            missSlots.resize(2*size);
+            missScores.resize(size*boardState::TOTAL_CELLS);
+        }
+    };
+};
+
+static thread_local inferenceWorkspace tWorkspace;
+
 ///
 /// \brief virtualPlayer::singleInstance Returns a pointer to this class singleton instance
 ///
@@ -58,129 +114,1112 @@ QSharedPointer<virtualPlayer> virtualPlayer::singleInstance()
 {
     if(mInstance==nullptr){
         mInstance = QSharedPointer<virtualPlayer>(new virtualPlayer());
-        qDebug() << "virtual player singleton instance created...";
+        qCDebug(engineLog) << "virtual player singleton instance created...";
     }
 
     return mInstance;
 }
 
 ///
-/// \brief virtualPlayer::multiplyVectors Matrix multiplication helper. Multiplies all the values in the vectors
-/// and acumulates the results.
+/// \brief virtualPlayer::virtualPlayer Default constructor, prepares the batched layers
 ///
 /// Miguel Mota
-/// Jan 5 2021
+/// Oct 17 2026
+///
+virtualPlayer::virtualPlayer() : mEngine(NEURAL_NETWORK), mTimeBudget(mctsEngine::DEFAULT_TIME_BUDGET),
+    mCancelFlag(std::make_shared<std::atomic<bool>>(false)),
+    mModel({layerMatrix(&t1[0][0], 20, 10), layerMatrix(&t2[0][0], 9, 21)}),
+    mQuantized(mModel.layers()), mBuiltInModel(true), mTopK(1),
+    mPonderThreads(0), mThreadPool(nullptr), mParallelThreshold(PARALLEL_THRESHOLD)
+{
+    qCDebug(engineLog) << "virtualPlayer constructor!";
+}
+
 ///
-/// \param v1 Vector 1
-/// \param v2 Vectro 2
+/// \brief virtualPlayer::setModel Replaces the network weights. Not thread safe, call it
+/// before asking for moves.
 ///
-/// \return The sum of all corresponding vector items multiplied.
+/// Miguel Mota
+/// Oct 17 2026
 ///
-double virtualPlayer::multiplyVectors(const QVector<double> &v1, const QVector<double> &v2)
+/// \param model New model, bias plus TOTAL_CELLS inputs and TOTAL_CELLS outputs
+///
+/// \return false if the model does not fit the board, the current one is kept then
+///
+bool virtualPlayer::setModel(const networkModel &model)
 {
-    double retVal = 0.00;
+    if(!model.fits(TOTAL_CELLS + 1, TOTAL_CELLS)){
+        qWarning() << "virtualPlayer: the model does not fit a" << TOTAL_CELLS << "cells board";
+        return false;
+    }
 
-    // just to make sure we check the size...
-    if(v1.size()==v2.size()){
-        int index=0;
-        for(const int val1 : v1){
-            retVal+=val1*v2[index++];
-        }
+    mModel = model;
+    mQuantized = quantizedNetwork(mModel.layers());
+    mBuiltInModel = false;
+    if(!mCache.isNull()){
+        mCache->clear();
     }
+    return true;
+}
 
-    return retVal;
+///
+/// \brief virtualPlayer::loadModel Maps a binary model file and uses it
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param fileName Binary model file, see networkModel
+///
+/// \return true if the model was loaded and fits the board
+///
+bool virtualPlayer::loadModel(const QString &fileName)
+{
+    networkModel model;
+    return model.loadBinary(fileName) && setModel(model);
 }
 
 ///
-/// \brief virtualPlayer::getLayer Calculates specific layer in the neural network
+/// \brief virtualPlayer::loadEndgame Maps an endgame database, the boards it was solved
+/// for are then played from it. Not thread safe, call it before asking for moves.
 ///
 /// Miguel Mota
+/// Oct 17 2026
+///
+/// \param fileName Database file, see tools/retrograde
+///
+/// \return true if the database was mapped
+///
+bool virtualPlayer::loadEndgame(const QString &fileName)
+{
+    if(!mEndgame.open(fileName)){
+        qWarning() << "endgame database not loaded:" << mEndgame.errorString();
+        return false;
+    }
+    return true;
+}
+
+///
+/// \brief virtualPlayer::setThreadPool Sets the pool used for parallel batch evaluation
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param pool Thread pool, nullptr selects the global Qt pool
+///
+void virtualPlayer::setThreadPool(QThreadPool *pool)
+{
+    mThreadPool = pool;
+}
+
+///
+/// \brief virtualPlayer::setParallelThreshold Sets the minimum amount of work for going parallel
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param multiplyAdds Batches with less multiply-adds than this are evaluated inline
+///
+void virtualPlayer::setParallelThreshold(const qint64 multiplyAdds)
+{
+    mParallelThreshold = multiplyAdds;
+}
+
+///
+/// \brief virtualPlayer::makeYourNextMove Calculates the next more using the neural network
+///
+/// Miguek Mota
 /// Jan 5 2021
 ///
-/// \param input Input values for the layer
-/// \param t Theta values
-/// \param addBias Specifies if a bias element must be added to the input
+/// \param board Current board elements.
+///
+void virtualPlayer::makeYourNextMove(boardState &board) const
+{
+    const int move = chooseMove(board);
+
+    if(move>=0){
+        // Make the move!
+        board.play(move, V_USER_MARK);
+    }
+}
+
+///
+/// \brief virtualPlayer::makeYourNextMove Calculates and plays the next move on a m,n,k board
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board elements.
+///
+void virtualPlayer::makeYourNextMove(mnkBoard &board) const
+{
+    const int move = chooseMove(board);
+
+    if(move>=0){
+        board.play(move, V_USER_MARK);
+    }
+}
+
 ///
-/// \return The values for each node in the layer.
+/// \brief virtualPlayer::chooseMove Calculates the next move on a m,n,k board. The classic
+/// board goes to the selected engine, the others to the Monte Carlo engine.
 ///
-QVector<double> virtualPlayer::getLayer(const QVector<double> input,
-                                        const QVector<QVector<double>> t,
-                                        const bool addBias) const
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board elements.
+///
+/// \return Cell index for the next move, -1 if the game is over.
+///
+int virtualPlayer::chooseMove(const mnkBoard &board) const
 {
-    QVector<double> retVal;
-    const int concurrentThreds = QThread::idealThreadCount(); // WARNING!!! assuming it never returns 0!
-    qDebug() << "Ideal threads count : " << concurrentThreds;
+    if(board.isOver()){
+        return -1;
+    }
+
+    if(board.isClassic()){
+        return chooseMove(board.toBoardState());
+    }
 
-    if(addBias)
-        retVal.append(BIAS_VALUE); // add bias...
+    if(mEndgame.covers(board)){
+        return mEndgame.bestMove(board, V_USER_MARK);
+    }
+
+    return searchMove(board);
+}
+
+///
+/// \brief virtualPlayer::searchMove Searches the next move with the Monte Carlo engine,
+/// using all the cores for the time budget.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board elements.
+/// \param cancelled If not null, raising it ends the search early
+///
+/// \return Cell index for the next move, -1 if the game is over.
+///
+int virtualPlayer::searchMove(const mnkBoard &board, const std::atomic<bool> *cancelled) const
+{
+    QMutexLocker ml(&mMctsMutex);
+
+    if(mMcts.isNull()){
+        mSearchPool.reset(new workStealingPool());
+        mMcts.reset(new mctsEngine(mSearchPool.data()));
+    }
+
+    mMcts->setTimeBudget(mTimeBudget);
+    const int move = mMcts->bestMove(board, V_USER_MARK, cancelled);
+
+    // Only built when the category is on, composing a message allocates
+    qCDebug(engineLog) << "MCTS: rollouts" << mMcts->lastStats().rollouts
+                       << "nodes" << mMcts->lastStats().nodes
+                       << "rollouts/s" << mMcts->lastStats().rolloutsPerSecond()
+                       << "threads" << mMcts->lastStats().threads;
+
+    return move;
+}
+
+///
+/// \brief virtualPlayer::chooseMoveAsync Chooses the next move on a thread of the global
+/// pool, the player must outlive the returned future.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board elements, copied.
+///
+/// \return Future cell index, -1 if the game is over or the move was cancelled first
+///
+QFuture<int> virtualPlayer::chooseMoveAsync(const mnkBoard &board) const
+{
+    // Already on its way if we saw this board coming
+    const QFuture<int> pondered = takePondered(board);
+    if(pondered.isValid()){
+        return pondered;
+    }
+
+    std::shared_ptr<std::atomic<bool>> cancelled;
+    {
+        QMutexLocker ml(&mCancelMutex);
+        cancelled = mCancelFlag;
+    }
 
-    // Matrix multiplication
-    for(int i=0; i<t.size(); i++){
-        // Start multiplying, using as many threads as we have available
-        // for for row*col multiplications...
-        QFuture<double> futures[concurrentThreds];
-        for(int j=0;j<concurrentThreds;j++){
-            futures[j] = QtConcurrent::run(multiplyVectors, t[i], input);
+    return QtConcurrent::run([this, board, cancelled]{
+        return cancellableMove(board, cancelled.get());
+    });
+}
+
+///
+/// \brief virtualPlayer::cancelMoves Cancels every move asked with chooseMoveAsync so far
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void virtualPlayer::cancelMoves() const
+{
+    stopPondering();
+
+    QMutexLocker ml(&mCancelMutex);
+    mCancelFlag->store(true);
+    mCancelFlag = std::make_shared<std::atomic<bool>>(false);
+}
+
+///
+/// \brief virtualPlayer::cancellableMove Chooses a move unless it is cancelled first,
+/// searches stop early when it is cancelled on the way.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board elements.
+/// \param cancelled Cancel flag
+///
+/// \return Cell index for the next move, -1 if the game is over or the move was cancelled
+///
+int virtualPlayer::cancellableMove(const mnkBoard &board, const std::atomic<bool> *cancelled) const
+{
+    if(cancelled->load()){
+        return -1;
+    }
+    return usesTimeBudget(board) ? searchMove(board, cancelled) : chooseMove(board);
+}
+
+///
+/// \brief virtualPlayer::setPonderThreads Turns pondering on or off. Not thread safe, call it
+/// before asking for moves.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param threads Pondering threads, 0 turns it off
+///
+void virtualPlayer::setPonderThreads(const int threads)
+{
+    stopPondering();
+
+    // The search engine is sized for the old thread count
+    if(!mPonderPool.isNull()){
+        mPonderPool->waitForDone();
+    }
+    mPonderMcts.reset();
+    mPonderSearchPool.reset();
+    mPonderThreads = qMax(0, threads);
+
+    if(threads<=0){
+        mPonderPool.reset();
+        return;
+    }
+
+    if(mPonderPool.isNull()){
+        mPonderPool.reset(new QThreadPool());
+        mPonderPool->setThreadPriority(QThread::LowPriority);
+    }
+    mPonderPool->setMaxThreadCount(threads);
+}
+
+///
+/// \brief virtualPlayer::ponder Starts preparing the replies to the user moves, the work
+/// left from the previous board is dropped. chooseMoveAsync picks up the reply when the
+/// user plays one of them. Instant engines answer every legal user move; searched
+/// replies go to ponderSearches.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board elements, the user to move.
+///
+void virtualPlayer::ponder(const mnkBoard &board) const
+{
+    stopPondering();
+
+    if(mPonderPool.isNull() || board.isOver()){
+        return;
+    }
+
+    QMutexLocker ml(&mPonderMutex);
+    if(usesTimeBudget(board)){
+        const std::shared_ptr<std::atomic<bool>> round = std::make_shared<std::atomic<bool>>(false);
+        mPonderRound = round;
+        mPonderPool->start([this, board, round]{
+            ponderSearches(board, round.get());
+        });
+        return;
+    }
+
+    for(int i=0; i<board.cellCount(); i++){
+        if(!board.isLegal(i)){
+            continue;
         }
 
-        // Collect results
-        double tmp = 0.00;
-        for(int j=0;j<concurrentThreds;j++){
-            tmp+=futures[j].result();
+        ponderedReply reply;
+        reply.board = board;
+        reply.board.play(i, USER_MARK);
+        if(reply.board.isOver()){
+            continue;
         }
-        retVal.push_back(g(tmp));
+
+        const mnkBoard replyBoard = reply.board;
+        const std::shared_ptr<std::atomic<bool>> cancelled = std::make_shared<std::atomic<bool>>(false);
+        reply.cancelled = cancelled;
+        reply.started = std::make_shared<std::atomic<bool>>(true);
+        reply.move = QtConcurrent::run(mPonderPool.data(), [this, replyBoard, cancelled]{
+            return cancellableMove(replyBoard, cancelled.get());
+        });
+        mPondered.append(reply);
     }
+}
 
-    return retVal;
+///
+/// \brief virtualPlayer::ponderSearches Prepares the searched replies of a pondering round.
+/// A short search from the user side ranks the user moves, then the replies to the
+/// likeliest ones are searched one at a time, for the whole time budget, on the low
+/// priority ponder engine. The CPU taken is bounded by the ponder threads and about
+/// PONDER_SEARCHES time budgets, and the main engine is never held.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board elements, the user to move.
+/// \param round Raised when the round is over, by the user move or a newer round
+///
+void virtualPlayer::ponderSearches(const mnkBoard &board, const std::atomic<bool> *round) const
+{
+    QMutexLocker sl(&mPonderMctsMutex);
+    if(round->load()){
+        return;
+    }
+
+    if(mPonderMcts.isNull()){
+        mPonderSearchPool.reset(new workStealingPool(mPonderThreads, QThread::LowPriority));
+        mPonderMcts.reset(new mctsEngine(mPonderSearchPool.data()));
+    }
+
+    mPonderMcts->setTimeBudget(qMax(1, mTimeBudget/PONDER_RANK_SHARE));
+    int moves[PONDER_SEARCHES];
+    const int count = mPonderMcts->rankMoves(board, USER_MARK, moves, PONDER_SEARCHES, round);
+
+    struct ponderJob {
+        mnkBoard board;
+        std::shared_ptr<QPromise<int>> promise;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        std::shared_ptr<std::atomic<bool>> started;
+    };
+    QVector<ponderJob> jobs;
+    {
+        // Listed all at once, a user move past the ranking still finds its reply pending
+        QMutexLocker ml(&mPonderMutex);
+        if(round->load()){
+            return;
+        }
+
+        for(int i=0; i<count; i++){
+            ponderJob job;
+            job.board = board;
+            job.board.play(moves[i], USER_MARK);
+            if(job.board.isOver()){
+                continue;
+            }
+            job.promise = std::make_shared<QPromise<int>>();
+            job.cancelled = std::make_shared<std::atomic<bool>>(false);
+            job.started = std::make_shared<std::atomic<bool>>(false);
+            job.promise->start();
+
+            ponderedReply reply;
+            reply.board = job.board;
+            reply.move = job.promise->future();
+            reply.cancelled = job.cancelled;
+            reply.started = job.started;
+            mPondered.append(reply);
+            jobs.append(job);
+        }
+    }
+
+    mPonderMcts->setTimeBudget(mTimeBudget);
+    for(const ponderJob &job : jobs){
+        int move = -1;
+        if(!job.cancelled->load()){
+            job.started->store(true);
+            move = usesTimeBudget(job.board) ? mPonderMcts->bestMove(job.board, V_USER_MARK, job.cancelled.get())
+                                             : chooseMove(job.board);
+        }
+        job.promise->addResult(job.cancelled->load() ? -1 : move);
+        job.promise->finish();
+    }
 }
 
 ///
-/// \brief virtualPlayer::makeYourNextMove Calculates the next more using the neural network
+/// \brief virtualPlayer::stopPondering Cancels the replies being prepared
 ///
-/// Miguek Mota
-/// Jan 5 2021
+/// Miguel Mota
+/// Oct 17 2026
+///
+void virtualPlayer::stopPondering() const
+{
+    QMutexLocker ml(&mPonderMutex);
+    if(mPonderRound){
+        mPonderRound->store(true);
+    }
+    for(const ponderedReply &reply : mPondered){
+        reply.cancelled->store(true);
+    }
+    mPondered.clear();
+}
+
+///
+/// \brief virtualPlayer::takePondered Looks for the reply prepared for a board, the
+/// replies to the other user moves are cancelled. A reply still waiting for its turn
+/// is dropped too, a fresh search on every core beats it.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board elements.
+///
+/// \return The reply, an invalid future if it was not being prepared
+///
+QFuture<int> virtualPlayer::takePondered(const mnkBoard &board) const
+{
+    QMutexLocker ml(&mPonderMutex);
+    if(mPonderRound){
+        mPonderRound->store(true);
+    }
+
+    // The hit stays listed, so cancelMoves() still reaches it
+    QVector<ponderedReply> hit;
+    for(const ponderedReply &reply : mPondered){
+        if(hit.isEmpty() && reply.board==board && reply.started->load()){
+            hit.append(reply);
+        }
+        else{
+            reply.cancelled->store(true);
+        }
+    }
+    mPondered = hit;
+
+    return hit.isEmpty() ? QFuture<int>() : hit.first().move;
+}
+
+///
+/// \brief virtualPlayer::usesTimeBudget Tells if the move for a board is searched for
+/// the whole time budget, instead of being computed right away.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board elements.
+///
+/// \return true for Monte Carlo searches
+///
+bool virtualPlayer::usesTimeBudget(const mnkBoard &board) const
+{
+    return (!board.isClassic() && !mEndgame.covers(board)) || mEngine==MCTS;
+}
+
+///
+/// \brief virtualPlayer::engineFromName Returns the engine matching a command line name
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param name Engine name: network, quantized, table, negamax or mcts
+///
+/// \return The engine, the neural network if the name is unknown
+///
+virtualPlayer::engineType virtualPlayer::engineFromName(const QString &name)
+{
+    if(name==QStringLiteral("quantized")){
+        return QUANTIZED_NETWORK;
+    }
+    if(name==QStringLiteral("table")){
+        return PERFECT_PLAY;
+    }
+    if(name==QStringLiteral("negamax")){
+        return NEGAMAX;
+    }
+    if(name==QStringLiteral("mcts")){
+        return MCTS;
+    }
+    if(name!=QStringLiteral("network")){
+        qWarning() << "Unknown engine" << name << ", using the neural network";
+    }
+    return NEURAL_NETWORK;
+}
+
+///
+/// \brief virtualPlayer::chooseMove Calculates the next move using the selected engine,
+/// the board is not modified.
+///
+/// Miguel Mota
+/// Oct 17 2026
 ///
 /// \param board Current board elements.
 ///
-void virtualPlayer::makeYourNextMove(QVector<QVector<int>> &board)
+/// \return Cell index for the next move, -1 if the game is over.
+///
+int virtualPlayer::chooseMove(const boardState &board) const
+{
+    switch(mEngine){
+        case PERFECT_PLAY:
+            return perfectPlay::bestMove(board, V_USER_MARK);
+        case NEGAMAX:
+        {
+            QMutexLocker ml(&mSolverMutex);
+            const int move = mSolver.bestMove(board, V_USER_MARK);
+            qCDebug(engineLog) << "Negamax: nodes" << mSolver.lastStats().nodes
+                               << "TT hit rate" << mSolver.lastStats().ttHitRate()
+                               << "time (us)" << mSolver.lastStats().elapsedNs/1000;
+            return move;
+        }
+        case MCTS:
+            return searchMove(mnkBoard(board));
+        case QUANTIZED_NETWORK:
+            return quantizedMove(board);
+        case NEURAL_NETWORK:
+            break;
+    };
+
+    return networkMove(board);
+}
+
+///
+/// \brief virtualPlayer::setCacheSize Turns the network result cache on or off. Not
+/// thread safe, call it before asking for moves.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param entries Cache entries, 0 turns it off
+///
+void virtualPlayer::setCacheSize(const int entries)
 {
-    QVector<double> input;
-    input.push_back(BIAS_VALUE); // add bias...
+    mCache.reset((entries>0) ? new inferenceCache(entries) : nullptr);
+}
+
+///
+/// \brief virtualPlayer::cacheStats Hit and miss counters of the network result cache
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \return Counters, all 0 when the cache is off
+///
+inferenceCache::cacheStats virtualPlayer::cacheStats() const
+{
+    return mCache.isNull() ? inferenceCache::cacheStats() : mCache->stats();
+}
+
+///
+/// \brief virtualPlayer::solverStats Returns the accumulated cost of the negamax engine
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \return Search statistics of all the moves made so far
+///
+negamaxSolver::searchStats virtualPlayer::solverStats() const
+{
+    QMutexLocker ml(&mSolverMutex);
+    return mSolver.totalStats();
+}
+
+///
+/// \brief virtualPlayer::networkMove Calculates the next move using the neural network,
+/// the board is not modified.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board elements.
+///
+/// \return Cell index for the next move, -1 if the game is over.
+///
+int virtualPlayer::networkMove(const boardState &board) const
+{
+    if(board.isOver()){
+        return -1;
+    }
+
+    int cells[TOTAL_CELLS];
+    double scores[TOTAL_CELLS];
+
+    if(!mCache.isNull()){
+        const int move = cachedScores(board, NEURAL_NETWORK, scores);
+        return (mTopK<=1) ? move : pickMove(scores, mTopK);
+    }
 
     // Convert the current items in the board
     // into the input layer for the neural network...
-    for(const QVector<int> &row : board){
-        for(const int &value : row){
-            input.append(static_cast<double>(value));
+    board.toCells(cells);
+
+    // Make neurons think!
+    networkScores(cells, scores);
+    maskOccupied(board, scores);
+
+    return pickMove(scores, mTopK);
+}
+
+///
+/// \brief virtualPlayer::quantizedMove Calculates the next move using the 8-bit copy of
+/// the neural network, the board is not modified.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board elements.
+///
+/// \return Cell index for the next move, -1 if the game is over.
+///
+int virtualPlayer::quantizedMove(const boardState &board) const
+{
+    if(board.isOver()){
+        return -1;
+    }
+
+    int cells[TOTAL_CELLS];
+    double scores[TOTAL_CELLS];
+
+    if(!mCache.isNull()){
+        const int move = cachedScores(board, QUANTIZED_NETWORK, scores);
+        return (mTopK<=1) ? move : pickMove(scores, mTopK);
+    }
+
+    board.toCells(cells);
+    mQuantized.evaluate(cells, 1, scores);
+    maskOccupied(board, scores);
+
+    return pickMove(scores, mTopK);
+}
+
+///
+/// \brief virtualPlayer::scoreMoves Network score of every cell for the next move, the
+/// quantized network when that is the engine. Occupied cells score ILLEGAL_MOVE_SCORE.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Current board elements.
+/// \param scores Output, TOTAL_CELLS scores
+///
+void virtualPlayer::scoreMoves(const boardState &board, double *scores) const
+{
+    if(!mCache.isNull()){
+        cachedScores(board, (mEngine==QUANTIZED_NETWORK) ? QUANTIZED_NETWORK : NEURAL_NETWORK, scores);
+        return;
+    }
+
+    int cells[TOTAL_CELLS];
+    board.toCells(cells);
+
+    if(mEngine==QUANTIZED_NETWORK){
+        mQuantized.evaluate(cells, 1, scores);
+    }
+    else{
+        networkScores(cells, scores);
+    }
+    maskOccupied(board, scores);
+}
+
+///
+/// \brief virtualPlayer::scoreMoves Batch version, TOTAL_CELLS masked scores per board
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param boards Boards to score
+/// \param boardCount Number of boards
+/// \param scores Output, boardCount*TOTAL_CELLS scores
+///
+void virtualPlayer::scoreMoves(const boardState *boards, const int boardCount, double *scores) const
+{
+    const engineType network = (mEngine==QUANTIZED_NETWORK) ? QUANTIZED_NETWORK : NEURAL_NETWORK;
+
+    if(!mCache.isNull()){
+        cachedScores(boards, boardCount, network, scores);
+        return;
+    }
+    batchScores(boards, boardCount, network, scores);
+}
+
+///
+/// \brief virtualPlayer::batchScores Masked scores of a batch, one pass of a network
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param boards Boards to score
+/// \param boardCount Number of boards
+/// \param network NEURAL_NETWORK or QUANTIZED_NETWORK
+/// \param scores Output, boardCount*TOTAL_CELLS scores
+///
+void virtualPlayer::batchScores(const boardState *boards, const int boardCount, const engineType network, double *scores) const
+{
+    if(network==QUANTIZED_NETWORK){
+        int *cells = tWorkspace.reserveCells(boardCount*TOTAL_CELLS);
+        for(int i=0; i<boardCount; i++){
+            boards[i].toCells(cells + i*TOTAL_CELLS);
         }
+        mQuantized.evaluate(cells, boardCount, scores);
+    }
+    else{
+        scoreBoards(boards, boardCount, scores);
     }
 
-    // Make neurons think!
-    QVector<double> layer1 = getLayer(input, t1, true);
-    QVector<double> output = getLayer(layer1, t2, false);
-
-    // Check if we have a result...
-    int outputIndex=0;
-    for(QVector<int> &row : board){
-        for(int &value : row){
-            if(static_cast<int>(qRound(output[outputIndex++]))==POSITIVE_RESULT && value==EMPTY_SPACE){
-                // Make the move!
-                value=V_USER_MARK;
-                return;
-            }
+    for(int i=0; i<boardCount; i++){
+        maskOccupied(boards[i], scores + i*TOTAL_CELLS);
+    }
+}
+
+///
+/// \brief virtualPlayer::networkScores Raw network output for one board, through the
+/// compile time network while the built-in model is in use.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param cells Board cells
+/// \param scores Output, TOTAL_CELLS scores
+///
+void virtualPlayer::networkScores(const int *cells, double *scores) const
+{
+    if(mBuiltInModel){
+        BUILT_IN_NETWORK.evaluate(cells, scores);
+    }
+    else{
+        scoreBoards(cells, 1, scores);
+    }
+}
+
+///
+/// \brief virtualPlayer::cachedScores Masked scores and best move of a board through the
+/// cache. On a miss the canonical copy of the board is scored, so all the symmetric
+/// boards get the same answer whichever comes first.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Board to score
+/// \param network NEURAL_NETWORK or QUANTIZED_NETWORK
+/// \param scores Output, TOTAL_CELLS scores
+///
+/// \return Best move, -1 if no cell is legal
+///
+int virtualPlayer::cachedScores(const boardState &board, const engineType network, double *scores) const
+{
+    int move = -1;
+    if(mCache->lookup(board, network, scores, &move)){
+        return move;
+    }
+
+    int symmetry = 0;
+    board.canonicalKey(&symmetry);
+    const boardState canonical = board.transformed(symmetry);
+
+    int cells[TOTAL_CELLS];
+    double canonicalScores[TOTAL_CELLS];
+    canonical.toCells(cells);
+    if(network==QUANTIZED_NETWORK){
+        mQuantized.evaluate(cells, 1, canonicalScores);
+    }
+    else{
+        networkScores(cells, canonicalScores);
+    }
+    maskOccupied(canonical, canonicalScores);
+
+    const int canonicalMove = pickMove(canonicalScores);
+    mCache->insert(canonical, network, canonicalScores, canonicalMove);
+
+    for(int i=0; i<TOTAL_CELLS; i++){
+        scores[i] = canonicalScores[boardState::SYMMETRIES[symmetry][i]];
+    }
+    return (canonicalMove<0) ? -1 : boardState::SYMMETRIES[boardState::INVERSE_SYMMETRY[symmetry]][canonicalMove];
+}
+
+///
+/// \brief virtualPlayer::cachedScores Batch version, the hits are answered from the
+/// cache and the canonical copies of the misses are scored together in one pass.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param boards Boards to score
+/// \param boardCount Number of boards
+/// \param network NEURAL_NETWORK or QUANTIZED_NETWORK
+/// \param scores Output, boardCount*TOTAL_CELLS scores
+///
+void virtualPlayer::cachedScores(const boardState *boards, const int boardCount, const engineType network,
+                                 double *scores) const
+{
+    tWorkspace.reserveMisses(boardCount);
+    boardState *misses = tWorkspace.misses.data();
+    int *slots = tWorkspace.missSlots.data();
+
+    int missCount = 0;
+    for(int i=0; i<boardCount; i++){
+        int move = -1;
+        if(mCache->lookup(boards[i], network, scores + i*TOTAL_CELLS, &move)){
+            continue;
         }
+
+        int symmetry = 0;
+        boards[i].canonicalKey(&symmetry);
+        misses[missCount] = boards[i].transformed(symmetry);
+        slots[2*missCount] = i;
+        slots[2*missCount + 1] = symmetry;
+        missCount++;
+    }
+    if(missCount==0){
+        return;
     }
 
-    qDebug() << "Neurons collapsed!";
+    double *missScores = tWorkspace.missScores.data();
+    batchScores(misses, missCount, network, missScores);
+
+    for(int i=0; i<missCount; i++){
+        const double *canonicalScores = missScores + i*TOTAL_CELLS;
+        mCache->insert(misses[i], network, canonicalScores, pickMove(canonicalScores));
+
+        double *boardScores = scores + slots[2*i]*TOTAL_CELLS;
+        for(int c=0; c<TOTAL_CELLS; c++){
+            boardScores[c] = canonicalScores[boardState::SYMMETRIES[slots[2*i + 1]][c]];
+        }
+    }
+}
+
+///
+/// \brief virtualPlayer::maskOccupied Gives occupied cells the lowest score
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param board Scored board
+/// \param scores TOTAL_CELLS scores
+///
+void virtualPlayer::maskOccupied(const boardState &board, double *scores)
+{
+    const uint16_t empty = board.emptyCells();
+    for(int i=0; i<TOTAL_CELLS; i++){
+        scores[i] = (empty & (1u << i)) ? scores[i] : ILLEGAL_MOVE_SCORE;
+    }
+}
+
+///
+/// \brief virtualPlayer::pickMove Turns masked scores into a move: the best cell, or
+/// a draw among the topK best in proportion to their scores.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param scores TOTAL_CELLS scores, occupied cells masked
+/// \param topK Number of candidates, 1 always plays the best cell
+///
+/// \return Cell index, -1 if no cell is legal
+///
+int virtualPlayer::pickMove(const double *scores, const int topK)
+{
+    int best = -1;
+    double bestScore = ILLEGAL_MOVE_SCORE;
+    for(int i=0; i<TOTAL_CELLS; i++){
+        if(scores[i]>bestScore){
+            bestScore = scores[i];
+            best = i;
+        }
+    }
+
+    if(topK<=1 || best<0){
+        return best;
+    }
+
+    // Legal cells, best first, kept to topK
+    int candidates[TOTAL_CELLS];
+    int count = 0;
+    for(int i=0; i<TOTAL_CELLS; i++){
+        if(scores[i]<=ILLEGAL_MOVE_SCORE){
+            continue;
+        }
+        int at = qMin(count, topK - 1);
+        if(count>=topK && scores[i]<=scores[candidates[at]]){
+            continue;
+        }
+        for(; at>0 && scores[candidates[at-1]]<scores[i]; at--){
+            candidates[at] = candidates[at-1];
+        }
+        candidates[at] = i;
+        count = qMin(count + 1, topK);
+    }
+
+    double total = 0.00;
+    for(int c=0; c<count; c++){
+        total += scores[candidates[c]];
+    }
+
+    double draw = QRandomGenerator::global()->generateDouble()*total;
+    for(int c=0; c<count; c++){
+        draw -= scores[candidates[c]];
+        if(draw<0){
+            return candidates[c];
+        }
+    }
+
+    return best;
+}
 
-    // If we are here neurons collapsed! just find the next available space.
-    // so they know we are alive...
-    for(QVector<int> &row : board){
-        for(int &value : row){
-            if(value==EMPTY_SPACE){
-                value=V_USER_MARK;
-                return;
+///
+/// \brief virtualPlayer::scoreBoards Evaluates the neural network for a batch of boards.
+/// Large batches are split in blocks of whole tiles across the thread pool, the calling
+/// thread evaluates the first block itself. Small batches never leave the calling thread.
+///
+/// Do not call it from a task already running in the same pool, it waits for its blocks.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param boards boardCount boards, TOTAL_CELLS row-major cell values each
+/// \param boardCount Number of boards in the batch
+/// \param scores Output, TOTAL_CELLS neuron values per board
+///
+void virtualPlayer::scoreBoards(const int *boards, const int boardCount, double *scores) const
+{
+    QThreadPool *pool = (mThreadPool!=nullptr) ? mThreadPool : QThreadPool::globalInstance();
+    const int tiles = (boardCount + BATCH_TILE - 1)/BATCH_TILE;
+    const int workers = qMin(pool->maxThreadCount() + 1, tiles); // pool threads + this one
+    qint64 work = 0;
+    for(const layerMatrix &layer : mModel.layers()){
+        work += static_cast<qint64>(boardCount)*layer.inputs()*layer.outputs();
+    }
+
+    if(workers<=1 || work<mParallelThreshold){
+        scoreTiles(boards, boardCount, scores);
+        return;
+    }
+
+    const int blockSize = ((tiles + workers - 1)/workers)*BATCH_TILE;
+
+    QVector<QFuture<void>> futures;
+    futures.reserve(workers);
+    for(int first=blockSize; first<boardCount; first+=blockSize){
+        const int count = qMin(blockSize, boardCount - first);
+        futures.append(QtConcurrent::run(pool, [this, boards, scores, first, count]{
+            scoreTiles(boards + first*TOTAL_CELLS, count, scores + first*TOTAL_CELLS);
+        }));
+    }
+
+    // No need to wait idle, we take the first block
+    scoreTiles(boards, qMin(blockSize, boardCount), scores);
+
+    for(QFuture<void> &future : futures){
+        future.waitForFinished();
+    }
+}
+
+///
+/// \brief virtualPlayer::scoreTiles Evaluates the neural network for a batch of boards
+/// in the calling thread. Boards are processed in tiles, so the working set stays in cache.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param boards boardCount boards, TOTAL_CELLS row-major cell values each
+/// \param boardCount Number of boards in the batch
+/// \param scores Output, TOTAL_CELLS neuron values per board
+///
+void virtualPlayer::scoreTiles(const int *boards, const int boardCount, double *scores) const
+{
+    const QVector<layerMatrix> &layers = mModel.layers();
+    const int last = layers.size() - 1;
+
+    // Row stride of the input of every layer, bias in the first column,
+    // and of the network output
+    const auto strideOf = [&](const int l){
+        return (l==0) ? layerMatrix::paddedSize(layers.first().inputs()) :
+               (l>last) ? layers.last().stride() : layerMatrix::paddedSize(layers[l-1].stride() + 1);
+    };
+
+    // One tile per layer input and one for the output, out of the thread workspace
+    int workspaceSize = 0;
+    for(int l=0; l<=last+1; l++){
+        workspaceSize += BATCH_TILE*strideOf(l);
+    }
+    double *workspace = tWorkspace.reserveValues(workspaceSize);
+
+    for(int first=0; first<boardCount; first+=BATCH_TILE){
+        const int tileSize = qMin(BATCH_TILE, boardCount - first);
+
+        // Input layer, bias + board cells...
+        for(int i=0; i<tileSize; i++){
+            double *in = workspace + i*strideOf(0);
+            const int *cells = boards + (first + i)*TOTAL_CELLS;
+            in[0] = BIAS_VALUE;
+            for(int j=0; j<TOTAL_CELLS; j++){
+                in[j+1] = static_cast<double>(cells[j]);
+            }
+        }
+
+        // Hidden layers, leaving room for the bias of the next one in the first column
+        double *in = workspace;
+        for(int l=0; l<last; l++){
+            double *out = in + BATCH_TILE*strideOf(l);
+            layers[l].multiply(in, strideOf(l), tileSize, out + 1, strideOf(l+1));
+            for(int i=0; i<tileSize; i++){
+                double *h = out + i*strideOf(l+1);
+                h[0] = BIAS_VALUE;
+                for(int j=1; j<=layers[l].outputs(); j++){
+                    h[j] = g(h[j]);
+                }
+            }
+            in = out;
+        }
+
+        // Output layer
+        double *out = in + BATCH_TILE*strideOf(last);
+        layers[last].multiply(in, strideOf(last), tileSize, out, strideOf(last+1));
+        for(int i=0; i<tileSize; i++){
+            const double *o = out + i*strideOf(last+1);
+            double *score = scores + (first + i)*TOTAL_CELLS;
+            for(int j=0; j<TOTAL_CELLS; j++){
+                score[j] = g(o[j]);
             }
         }
     }
 }
+
+///
+/// \brief virtualPlayer::scoreBoards Convenience overload of the batch API
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param boards Flat list of boards, TOTAL_CELLS row-major cell values each
+///
+/// \return TOTAL_CELLS neuron values per board
+///
+QVector<double> virtualPlayer::scoreBoards(const QVector<int> &boards) const
+{
+    const int boardCount = boards.size()/TOTAL_CELLS;
+    QVector<double> retVal(boardCount*TOTAL_CELLS, 0.00);
+
+    scoreBoards(boards.constData(), boardCount, retVal.data());
+
+    return retVal;
+}
+
+///
+/// \brief virtualPlayer::scoreBoards Batch API overload for compact board states
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param boards boardCount board states
+/// \param boardCount Number of boards in the batch
+/// \param scores Output, TOTAL_CELLS neuron values per board
+///
+void virtualPlayer::scoreBoards(const boardState *boards, const int boardCount, double *scores) const
+{
+    int *cells = tWorkspace.reserveCells(boardCount*TOTAL_CELLS);
+
+    for(int i=0; i<boardCount; i++){
+        boards[i].toCells(cells + i*TOTAL_CELLS);
+    }
+
+    scoreBoards(cells, boardCount, scores);
+}
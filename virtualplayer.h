@@ -1,10 +1,31 @@
 #ifndef VIRTUALPLAYER_H
 #define VIRTUALPLAYER_H
 
+#include "networkmodel.h"
+#include "quantizednetwork.h"
+#include "inferencecache.h"
+#include "endgamedatabase.h"
+#include "boardstate.h"
+#include "mnkboard.h"
+#include "negamaxsolver.h"
+#include "mctsengine.h"
+
 #include <QVector>
+#include <QFuture>
 #include <QSharedPointer>
+#include <QMutex>
+#include <QScopedPointer>
+#include <QThreadPool>
+#include <QLoggingCategory>
 #include <QDebug>
 
+#include <atomic>
+#include <memory>
+
+// Engine messages, one or more per move. Debug output is off by default, turn it on
+// with QT_LOGGING_RULES="tictactoe.engine.debug=true"
+Q_DECLARE_LOGGING_CATEGORY(engineLog)
+
 ///
 /// \brief The virtualPlayer class
 ///
@@ -16,19 +37,150 @@ class virtualPlayer
 public:
     static QSharedPointer<virtualPlayer> singleInstance();
 
-    virtualPlayer(){ qDebug() << "virtualPlayer constructor!"; };
-    ~virtualPlayer() { qDebug() << "virtualPlayer destroyed!"; };
+    static const int TOTAL_CELLS = boardState::TOTAL_CELLS;
+    static constexpr double ILLEGAL_MOVE_SCORE = -1.00; // below any network output
+
+    // Available move engines
+    enum engineType {NEURAL_NETWORK, QUANTIZED_NETWORK, PERFECT_PLAY, NEGAMAX, MCTS};
+
+    static engineType engineFromName(const QString &name);
+
+    // Engines fast enough for tools playing many games, MCTS thinks for its whole
+    // time budget on every move
+    static bool isBulkEngine(const engineType engine) { return engine!=MCTS; };
+
+    // Engines scoring a batch of boards in one pass, see scoreMoves
+    static bool isNetworkEngine(const engineType engine) { return engine==NEURAL_NETWORK || engine==QUANTIZED_NETWORK; };
+
+    virtualPlayer();
+    ~virtualPlayer() { stopPondering(); qCDebug(engineLog) << "virtualPlayer destroyed!"; };
+
+    void makeYourNextMove(boardState &board) const;
+    void makeYourNextMove(mnkBoard &board) const;
+    int chooseMove(const boardState &board) const;
+    int chooseMove(const mnkBoard &board) const;
+    int networkMove(const boardState &board) const;
+    int quantizedMove(const boardState &board) const;
+    int searchMove(const mnkBoard &board, const std::atomic<bool> *cancelled = nullptr) const;
+
+    // Moves on a worker thread, cancelMoves() ends the ones not delivered yet with -1
+    // or, for searches already running, with the best move found so far
+    QFuture<int> chooseMoveAsync(const mnkBoard &board) const;
+    void cancelMoves() const;
+
+    // Pondering: while the user thinks, the replies to the user moves are prepared on
+    // low priority threads, this many, 0 turns it off (default). Instant engines answer
+    // every user move; searched replies are limited to the likeliest user moves, one
+    // search at a time on a search engine of their own.
+    void setPonderThreads(const int threads);
+    void ponder(const mnkBoard &board) const;
+    void stopPondering() const;
+
+    void setEngine(const engineType engine) { mEngine = engine; };
+    engineType engine() const { return mEngine; };
+
+    // Per-move time budget of the search engines
+    void setTimeBudget(const int milliseconds) { mTimeBudget = qMax(1, milliseconds); };
+    int timeBudget() const { return mTimeBudget; };
+    bool usesTimeBudget(const mnkBoard &board) const;
+
+    negamaxSolver::searchStats solverStats() const;
+
+    // Symmetry aware cache of the network results, 0 entries turns it off (default)
+    void setCacheSize(const int entries);
+    inferenceCache::cacheStats cacheStats() const;
 
-    void makeYourNextMove(QVector<QVector<int>> &board);
+    // Network weights, the built-in model unless replaced
+    bool setModel(const networkModel &model);
+    bool loadModel(const QString &fileName);
+    const networkModel &model() const { return mModel; };
+    const quantizedNetwork &quantized() const { return mQuantized; };
+
+    // Solved positions of a bigger board, played by lookup instead of searched
+    bool loadEndgame(const QString &fileName);
+    const endgameDatabase &endgame() const { return mEndgame; };
+
+    // Parallel execution settings
+    void setThreadPool(QThreadPool *pool);
+    void setParallelThreshold(const qint64 multiplyAdds);
+
+    // Network moves: the best scored cell, or a draw among the topK best
+    void setTopK(const int topK) { mTopK = qBound(1, topK, TOTAL_CELLS); };
+    int topK() const { return mTopK; };
+
+    // Move scores of the network engines, occupied cells masked. With the cache on the
+    // batch version answers the hits from it and scores the misses in one pass
+    void scoreMoves(const boardState &board, double *scores) const;
+    void scoreMoves(const boardState *boards, const int boardCount, double *scores) const;
+    static int pickMove(const double *scores, const int topK = 1);
+
+    // Batch inference API, raw network output
+    void scoreBoards(const int *boards, const int boardCount, double *scores) const;
+    QVector<double> scoreBoards(const QVector<int> &boards) const;
+    void scoreBoards(const boardState *boards, const int boardCount, double *scores) const;
 
 protected:
     static QSharedPointer<virtualPlayer> mInstance;
 
-    static double multiplyVectors(const QVector<double> &v1, const QVector<double> &v2);
+    engineType mEngine;
+
+    // Search engine, its table is shared by all the callers
+    mutable negamaxSolver mSolver;
+    mutable QMutex mSolverMutex;
+
+    // Monte Carlo engine and its workers, created on first use
+    mutable QScopedPointer<workStealingPool> mSearchPool;
+    mutable QScopedPointer<mctsEngine> mMcts;
+    mutable QMutex mMctsMutex;
+    int mTimeBudget;
+
+    // Raised by cancelMoves(), then replaced for the moves to come
+    mutable std::shared_ptr<std::atomic<bool>> mCancelFlag;
+    mutable QMutex mCancelMutex;
+
+    // Reply being prepared for a board the user may leave
+    struct ponderedReply {
+        mnkBoard board;
+        QFuture<int> move;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        std::shared_ptr<std::atomic<bool>> started;
+    };
+    mutable QVector<ponderedReply> mPondered;
+    mutable QMutex mPonderMutex;
+    int mPonderThreads;
+
+    // Searched replies: cancel flag of the current round, and their engine, low
+    // priority and created on first use
+    mutable std::shared_ptr<std::atomic<bool>> mPonderRound;
+    mutable QScopedPointer<workStealingPool> mPonderSearchPool;
+    mutable QScopedPointer<mctsEngine> mPonderMcts;
+    mutable QMutex mPonderMctsMutex;
+
+    // Network layers, padded for batched evaluation
+    networkModel mModel;
+    quantizedNetwork mQuantized;
+    bool mBuiltInModel;  // single moves go through the compile time copy
+    int mTopK;
+    QScopedPointer<inferenceCache> mCache;
+    endgameDatabase mEndgame;
+
+    // Pool for big batches, nullptr means the global pool
+    QThreadPool *mThreadPool;
+    qint64 mParallelThreshold;
+
+    // Last, its threads must be done before anything else goes
+    QScopedPointer<QThreadPool> mPonderPool;
+
     double g(const double z) const { return (1/(qExp(-1*z)+1)); }; // Sigmoid function!
-    QVector<double> getLayer(const QVector<double> input,
-                             const QVector<QVector<double>> t,
-                             const bool addBias) const;
+    void scoreTiles(const int *boards, const int boardCount, double *scores) const;
+    void networkScores(const int *cells, double *scores) const;
+    int cancellableMove(const mnkBoard &board, const std::atomic<bool> *cancelled) const;
+    QFuture<int> takePondered(const mnkBoard &board) const;
+    void ponderSearches(const mnkBoard &board, const std::atomic<bool> *round) const;
+    int cachedScores(const boardState &board, const engineType network, double *scores) const;
+    void cachedScores(const boardState *boards, const int boardCount, const engineType network, double *scores) const;
+    void batchScores(const boardState *boards, const int boardCount, const engineType network, double *scores) const;
+    static void maskOccupied(const boardState &board, double *scores);
 };
 
 #endif // VIRTUALPLAYER_H
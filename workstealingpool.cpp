@@ -0,0 +1,232 @@
+#include "workstealingpool.h"
+
+const unsigned long IDLE_WAIT_TIME = 10; // ms, the waiting thread polls for tasks to help with
+
+// Pool and worker index of the calling thread
+static thread_local const workStealingPool *tCurrentPool = nullptr;
+static thread_local int tCurrentWorker = -1;
+
+///
+/// \brief The workStealingPool::worker class, runs the worker loop
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class workStealingPool::worker : public QThread
+{
+public:
+    worker(workStealingPool *pool, const int index) : mPool(pool), mIndex(index) {};
+
+protected:
+    workStealingPool *mPool;
+    int mIndex;
+
+    void run() override {
+        tCurrentPool = mPool;
+        tCurrentWorker = mIndex;
+        mPool->workerLoop(mIndex);
+    };
+};
+
+///
+/// \brief workStealingPool::workStealingPool Main constructor, starts the workers
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param threads Number of worker threads
+/// \param priority Worker thread priority
+///
+workStealingPool::workStealingPool(const int threads, const QThread::Priority priority) :
+    mQueued(0), mPending(0), mNextQueue(0), mStop(false)
+{
+    const int total = qMax(1, threads);
+
+    for(int i=0; i<total; i++){
+        mQueues.append(new taskQueue);
+    }
+    for(int i=0; i<total; i++){
+        mWorkers.append(new worker(this, i));
+        mWorkers.last()->start(priority);
+    }
+}
+
+///
+/// \brief workStealingPool::~workStealingPool Destructor, finishes the pending tasks and stops the workers
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+workStealingPool::~workStealingPool()
+{
+    wait();
+
+    {
+        QMutexLocker ml(&mSleepMutex);
+        mStop = true;
+        mWorkAvailable.wakeAll();
+    }
+
+    for(worker *w : mWorkers){
+        w->wait();
+        delete w;
+    }
+    qDeleteAll(mQueues);
+}
+
+///
+/// \brief workStealingPool::currentWorker Returns the worker running the calling thread
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \return Worker index, -1 if the calling thread does not belong to this pool
+///
+int workStealingPool::currentWorker() const
+{
+    return (tCurrentPool==this) ? tCurrentWorker : -1;
+}
+
+///
+/// \brief workStealingPool::submit Queues a task. Workers queue in their own deque,
+/// other threads spread their tasks round-robin.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param task Task to run
+///
+void workStealingPool::submit(std::function<void()> task)
+{
+    int index = currentWorker();
+    if(index<0){
+        index = mNextQueue.fetch_add(1, std::memory_order_relaxed) % mQueues.size();
+    }
+
+    mPending.fetch_add(1);
+    {
+        QMutexLocker ml(&mQueues[index]->mutex);
+        mQueues[index]->tasks.push_back(std::move(task));
+    }
+    mQueued.fetch_add(1);
+
+    // Wake up a sleeping worker, if any
+    QMutexLocker ml(&mSleepMutex);
+    mWorkAvailable.wakeOne();
+}
+
+///
+/// \brief workStealingPool::takeTask Takes the newest task of our own deque,
+/// or steals the oldest one from another deque.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param self Worker index, -1 for threads outside the pool
+/// \param task Returns the task
+///
+/// \return true if a task was found
+///
+bool workStealingPool::takeTask(const int self, std::function<void()> &task)
+{
+    if(mQueued.load()==0){
+        return false;
+    }
+
+    if(self>=0){
+        QMutexLocker ml(&mQueues[self]->mutex);
+        if(!mQueues[self]->tasks.empty()){
+            task = std::move(mQueues[self]->tasks.back());
+            mQueues[self]->tasks.pop_back();
+            mQueued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    const int total = mQueues.size();
+    for(int i=1; i<=total; i++){
+        const int victim = (qMax(self, 0) + i) % total;
+        QMutexLocker ml(&mQueues[victim]->mutex);
+        if(!mQueues[victim]->tasks.empty()){
+            task = std::move(mQueues[victim]->tasks.front());
+            mQueues[victim]->tasks.pop_front();
+            mQueued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+///
+/// \brief workStealingPool::runTask Runs a task and signals the waiting threads when the last one finishes
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param task Task to run
+///
+void workStealingPool::runTask(std::function<void()> &task)
+{
+    task();
+    task = nullptr;
+
+    if(mPending.fetch_sub(1)==1){
+        QMutexLocker ml(&mSleepMutex);
+        mAllDone.wakeAll();
+    }
+}
+
+///
+/// \brief workStealingPool::workerLoop Worker thread main loop
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+/// \param self Worker index
+///
+void workStealingPool::workerLoop(const int self)
+{
+    std::function<void()> task;
+
+    while(true){
+        if(takeTask(self, task)){
+            runTask(task);
+            continue;
+        }
+
+        // Nothing to do, sleep until something gets queued
+        QMutexLocker ml(&mSleepMutex);
+        while(!mStop && mQueued.load()==0){
+            mWorkAvailable.wait(&mSleepMutex);
+        }
+        if(mStop){
+            return;
+        }
+    }
+}
+
+///
+/// \brief workStealingPool::wait Waits until every submitted task has finished.
+/// The calling thread runs queued tasks too, instead of waiting idle.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+void workStealingPool::wait()
+{
+    const int self = currentWorker();
+    std::function<void()> task;
+
+    while(mPending.load()>0){
+        if(takeTask(self, task)){
+            runTask(task);
+            continue;
+        }
+
+        QMutexLocker ml(&mSleepMutex);
+        if(mPending.load()>0){
+            mAllDone.wait(&mSleepMutex, IDLE_WAIT_TIME);
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <QVector>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+
+///
+/// \brief The workStealingPool class
+///
+/// Fixed set of worker threads, each one with its own task deque. A
+/// worker pushes and pops its own tasks at the back (newest first, warm
+/// caches) and, when it runs dry, steals the oldest task from the front
+/// of another worker's deque. Tasks submitted from outside the pool are
+/// dealt round-robin. Tasks may submit more tasks, but must not call
+/// wait(), it would wait for themselves.
+///
+/// Miguel Mota
+/// Oct 17 2026
+///
+class workStealingPool
+{
+public:
+    explicit workStealingPool(const int threads = QThread::idealThreadCount(),
+                              const QThread::Priority priority = QThread::InheritPriority);
+    ~workStealingPool();
+
+    int threadCount() const { return mWorkers.size(); };
+
+    void submit(std::function<void()> task);
+    void wait();
+
+    // Worker running the calling thread, -1 outside the pool
+    int currentWorker() const;
+
+protected:
+    class worker;
+
+    struct taskQueue {
+        QMutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    QVector<worker*> mWorkers;
+    QVector<taskQueue*> mQueues;
+    std::atomic<int> mQueued;   // tasks waiting in the deques
+    std::atomic<int> mPending;  // tasks submitted and not finished yet
+    std::atomic<int> mNextQueue;
+    std::atomic<bool> mStop;
+
+    QMutex mSleepMutex;
+    QWaitCondition mWorkAvailable;
+    QWaitCondition mAllDone;
+
+    bool takeTask(const int self, std::function<void()> &task);
+    void runTask(std::function<void()> &task);
+    void workerLoop(const int self);
+};
+
+#endif // WORKSTEALINGPOOL_H